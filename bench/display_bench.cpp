@@ -0,0 +1,266 @@
+/* LCD backend benchmark
+************************
+
+Times the display backends with Timer1 running at the CPU clock, built by
+the bench_lcd_* environments in platformio.ini and run under simavr by
+tools/muses_bench.py, same output as bench/muses_bench.cpp. Each call is
+timed until it returns (what the caller is blocked for) and until the
+controller takes the next instruction (idle). Build the _fixed environments
+as well to see what the hold-offs save against the worst-case delays.
+
+Timer0 keeps running, the hold-offs are timed with micros(), so its
+interrupt lands in some of the timings.
+
+The I2C backend needs a device acknowledging address 0x27, otherwise every
+transaction stops after the address byte. tools/muses_bench.py runs the
+lcd_i2c environments with one attached (tools/simavr_twi_peer.c) and fails
+on rows reporting dropped transactions.
+
+Build flags:
+	DISPLAY_BENCH_BACKEND	0 PCF8574 I2C backpack, 1 4-bit parallel,
+				2 null
+	HD44780_FIXED_DELAYS	wait out every hold-off in the call
+
+Output, one line per call, fields separated by spaces:
+	bench <config> <call> <calls> <mean cycles> <max cycles> <mean idle cycles> <errors>
+followed by "bench end". errors counts the I2C transactions NACKed or lost
+during the call's runs.
+
+*/
+
+#include <Arduino.h>
+#include <util/atomic.h>
+#include <FrameBuffer.h>
+
+#ifndef DISPLAY_BENCH_BACKEND
+#define DISPLAY_BENCH_BACKEND 0
+#endif
+
+#define BENCH_CALLS 16 // calls per function
+
+#if DISPLAY_BENCH_BACKEND == 1
+#include <Hd44780Parallel.h>
+Hd44780Parallel lcd(A0, A2, A3, A4, A5, 9, 20, 4);
+#elif DISPLAY_BENCH_BACKEND == 2
+#include <NullDisplay.h>
+NullDisplay lcd;
+#else
+#include <Hd44780I2c.h>
+#include <TwiAsync.h>
+Hd44780I2c lcd(0x27, 20, 4);
+#endif
+
+FrameBuffer screen;
+
+static const uint8_t glyph[8] = {0x1F, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1F};
+
+struct result_t
+{
+	const __FlashStringHelper *name;
+	uint32_t total;		 // cycles until the call returned, summed
+	uint32_t worst;		 // longest single call
+	uint32_t total_idle; // cycles until the controller was ready, summed
+	uint16_t errors;	 // I2C transactions dropped
+};
+
+// Timer1 overflows, extends TCNT1 to 32 bits
+volatile uint16_t overflows;
+
+ISR(TIMER1_OVF_vect)
+{
+	overflows++;
+}
+
+static uint32_t cycles()
+{
+	uint16_t high;
+	uint16_t low;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		low = TCNT1;
+		high = overflows;
+		// an overflow between the interrupt being disabled and the read
+		if ((TIFR1 & _BV(TOV1)) && low < 0x8000)
+		{
+			high++;
+		}
+	}
+	return ((uint32_t)high << 16) | low;
+}
+
+static uint16_t busErrors()
+{
+#if DISPLAY_BENCH_BACKEND == 0
+	return TwiAsync::getErrors();
+#else
+	return 0;
+#endif
+}
+
+// everything sent and executed
+static void waitIdle()
+{
+#if DISPLAY_BENCH_BACKEND == 0
+	TwiAsync::flush();
+#endif
+	while (!lcd.ready())
+	{
+	}
+}
+
+// the benchmarked calls, i is the iteration so the framebuffer always has
+// something to send
+
+static void callNothing(uint8_t)
+{
+}
+
+static void callClear(uint8_t)
+{
+	lcd.clear();
+}
+
+static void callHome(uint8_t)
+{
+	lcd.home();
+}
+
+// a character at a new position
+static void callCharacter(uint8_t i)
+{
+	lcd.setCursor(i & 15, 0);
+	lcd.write('0' + (i & 7));
+}
+
+// a whole line as one run
+static void callLine(uint8_t i)
+{
+	uint8_t line[FrameBuffer::cols];
+	memset(line, '0' + (i & 7), sizeof(line));
+	lcd.setCursor(0, 1);
+	lcd.write(line, sizeof(line));
+}
+
+static void callCreateChar(uint8_t i)
+{
+	lcd.createChar(i & 7, glyph);
+}
+
+// a volume step as the UI draws it
+static void callFlush(uint8_t i)
+{
+	screen.setCursor(0, 3);
+	screen.print(i & 1 ? F(" -23.75") : F(" -24.00"));
+	screen.flush(lcd);
+}
+
+// clear the display and draw a line, as after a screen change
+static void callClearFlush(uint8_t i)
+{
+	lcd.clear();
+	screen.clear();
+	screen.invalidate();
+	screen.setCursor(0, 0);
+	screen.print(i & 1 ? F("Phono") : F("Media"));
+	while (screen.dirty())
+	{
+		screen.flush(lcd);
+	}
+}
+
+static uint32_t overhead;
+
+static void bench(result_t &result, const __FlashStringHelper *name, void (*call)(uint8_t))
+{
+	result.name = name;
+	result.total = 0;
+	result.worst = 0;
+	result.total_idle = 0;
+	uint16_t errors = busErrors();
+	for (uint8_t i = 0; i < BENCH_CALLS; i++)
+	{
+		waitIdle();
+		uint32_t start = cycles();
+		call(i);
+		uint32_t returned = cycles();
+		waitIdle();
+		uint32_t done = cycles();
+
+		uint32_t spent = returned - start - overhead;
+		result.total += spent;
+		result.total_idle += done - start - overhead;
+		if (spent > result.worst)
+		{
+			result.worst = spent;
+		}
+	}
+	result.errors = busErrors() - errors;
+}
+
+static void print(const result_t &result)
+{
+	Serial.print(F("bench "));
+#if DISPLAY_BENCH_BACKEND == 1
+	Serial.print(F("lcd_parallel"));
+#elif DISPLAY_BENCH_BACKEND == 2
+	Serial.print(F("lcd_null"));
+#else
+	Serial.print(F("lcd_i2c"));
+#endif
+#ifdef HD44780_FIXED_DELAYS
+	Serial.print(F("+fixed"));
+#endif
+	Serial.print(' ');
+	Serial.print(result.name);
+	Serial.print(' ');
+	Serial.print(BENCH_CALLS);
+	Serial.print(' ');
+	Serial.print(result.total / BENCH_CALLS);
+	Serial.print(' ');
+	Serial.print(result.worst);
+	Serial.print(' ');
+	Serial.print(result.total_idle / BENCH_CALLS);
+	Serial.print(' ');
+	Serial.println(result.errors);
+}
+
+void setup()
+{
+	// Timer1 free running at the CPU clock
+	TCCR1A = 0;
+	TCCR1B = _BV(CS10);
+	TIMSK1 = _BV(TOIE1);
+
+	lcd.begin();
+	Serial.begin(115200);
+
+	// cost of the timing itself and an empty call through the pointer
+	result_t results[7];
+	bench(results[0], F("nothing"), callNothing);
+	overhead = results[0].total / BENCH_CALLS;
+
+	bench(results[0], F("clear"), callClear);
+	bench(results[1], F("home"), callHome);
+	bench(results[2], F("character"), callCharacter);
+	bench(results[3], F("line"), callLine);
+	bench(results[4], F("createChar"), callCreateChar);
+	bench(results[5], F("flush"), callFlush);
+	bench(results[6], F("clear_flush"), callClearFlush);
+	waitIdle();
+
+	for (uint8_t i = 0; i < 7; i++)
+	{
+		print(results[i]);
+	}
+	Serial.println(F("bench end"));
+	Serial.flush();
+
+	// simavr exits when the core sleeps with interrupts off
+	cli();
+	SMCR = _BV(SE);
+	asm volatile("sleep");
+}
+
+void loop()
+{
+}
@@ -0,0 +1,232 @@
+/* Muses72323 write path benchmark
+**********************************
+
+Times the driver API calls with Timer1 running at the CPU clock, built by the
+bench_* environments in platformio.ini and run under simavr by
+tools/muses_bench.py. Each call is timed twice: until it returns (what the
+caller is blocked for) and until the transport is idle again (the bus time
+of the whole write). Results go out over the UART once all timing is done,
+the USART transport owns the UART while it runs.
+
+Build flags:
+	MUSES_BENCH_TRANSPORT	0 hardware SPI, 1 hardware SPI async,
+				2 USART in SPI mode, 3 bit banged
+	MUSES72323_TRACE	record every write in the trace ring
+
+Output, one line per call, fields separated by spaces:
+	bench <config> <call> <calls> <mean cycles> <max cycles> <mean idle cycles>
+followed by "bench end".
+
+*/
+
+#include <Arduino.h>
+#include <Muses72323.h>
+#include <Muses72323Transport.h>
+#include <util/atomic.h>
+#include <DecibelText.h>
+
+#ifndef MUSES_BENCH_TRANSPORT
+#define MUSES_BENCH_TRANSPORT 0
+#endif
+
+#define BENCH_CALLS 32 // calls per API function
+#define address_Muses 0
+#define muses_CS 10
+
+#if MUSES_BENCH_TRANSPORT == 2
+typedef Muses72323UsartSpi<muses_CS> BenchTransport;
+#elif MUSES_BENCH_TRANSPORT == 3
+typedef Muses72323BitBang<muses_CS, 11, 13> BenchTransport;
+#else
+typedef Muses72323HardwareSpi<muses_CS> BenchTransport;
+#endif
+
+Muses72323<BenchTransport> Muses(address_Muses);
+
+struct result_t
+{
+	const __FlashStringHelper *name;
+	uint32_t total;		 // cycles until the call returned, summed
+	uint32_t worst;		 // longest single call
+	uint32_t total_idle; // cycles until the transport was idle, summed
+};
+
+// Timer1 overflows, extends TCNT1 to 32 bits
+volatile uint16_t overflows;
+
+ISR(TIMER1_OVF_vect)
+{
+	overflows++;
+}
+
+static uint32_t cycles()
+{
+	uint16_t high;
+	uint16_t low;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+	{
+		low = TCNT1;
+		high = overflows;
+		// an overflow between the interrupt being disabled and the read
+		if ((TIFR1 & _BV(TOV1)) && low < 0x8000)
+		{
+			high++;
+		}
+	}
+	return ((uint32_t)high << 16) | low;
+}
+
+// the benchmarked calls, i is the iteration so levels alternate and the
+// shadow registers never elide the write
+
+static void callNothing(uint8_t)
+{
+}
+
+static void callSetVolume(uint8_t i)
+{
+	Muses.setVolume(i & 1 ? -80 : -84, i & 1 ? -80 : -84);
+}
+
+static void callSetVolumeElided(uint8_t)
+{
+	Muses.setVolume(-80, -80);
+}
+
+static void callSetLevel(uint8_t i)
+{
+	Muses.setLevel(i & 1 ? -80 : 8, i & 1 ? -84 : 8);
+}
+
+static void callMute(uint8_t)
+{
+	Muses.invalidate();
+	Muses.mute();
+}
+
+static void callUrgentMute(uint8_t)
+{
+	Muses.urgentMute();
+}
+
+// the display text for a level, -32768 is the slowest input
+static void callFormatQuarterDb(uint8_t i)
+{
+	char text[s_decibel_text_size];
+	formatQuarterDb(text, i & 1 ? -32768 : -95);
+}
+
+// the register set written by setup() in src/main.cpp
+static void callInit(uint8_t)
+{
+	Muses.invalidate();
+	Muses.beginCommit();
+	Muses.setExternalClock(false);
+	Muses.setZeroCrossingOn(true);
+	Muses.setSoftStep(true);
+	Muses.mute();
+	Muses.commit();
+}
+
+static uint32_t overhead;
+
+static void bench(result_t &result, const __FlashStringHelper *name, void (*call)(uint8_t))
+{
+	result.name = name;
+	result.total = 0;
+	result.worst = 0;
+	result.total_idle = 0;
+	for (uint8_t i = 0; i < BENCH_CALLS; i++)
+	{
+		Muses.flush();
+		uint32_t start = cycles();
+		call(i);
+		uint32_t returned = cycles();
+		Muses.flush();
+		uint32_t done = cycles();
+
+		uint32_t spent = returned - start - overhead;
+		result.total += spent;
+		result.total_idle += done - start - overhead;
+		if (spent > result.worst)
+		{
+			result.worst = spent;
+		}
+	}
+}
+
+static void print(const result_t &result)
+{
+	Serial.print(F("bench "));
+#if MUSES_BENCH_TRANSPORT == 1
+	Serial.print(F("hw_async"));
+#elif MUSES_BENCH_TRANSPORT == 2
+	Serial.print(F("usart"));
+#elif MUSES_BENCH_TRANSPORT == 3
+	Serial.print(F("bitbang"));
+#else
+	Serial.print(F("hw"));
+#endif
+#ifdef MUSES72323_TRACE
+	Serial.print(F("+trace"));
+#endif
+	Serial.print(' ');
+	Serial.print(result.name);
+	Serial.print(' ');
+	Serial.print(BENCH_CALLS);
+	Serial.print(' ');
+	Serial.print(result.total / BENCH_CALLS);
+	Serial.print(' ');
+	Serial.print(result.worst);
+	Serial.print(' ');
+	Serial.println(result.total_idle / BENCH_CALLS);
+}
+
+void setup()
+{
+	// Timer1 free running at the CPU clock
+	TCCR1A = 0;
+	TCCR1B = _BV(CS10);
+	TIMSK1 = _BV(TOIE1);
+	// stop the millis() interrupt landing in the timings, only the trace
+	// timestamps read micros()
+	TIMSK0 = 0;
+
+	Muses.begin();
+#if MUSES_BENCH_TRANSPORT == 1
+	Muses.setAsync(true);
+#endif
+	callInit(0);
+
+	// cost of the timing itself and an empty call through the pointer
+	result_t results[7];
+	bench(results[0], F("nothing"), callNothing);
+	overhead = results[0].total / BENCH_CALLS;
+
+	bench(results[0], F("setVolume"), callSetVolume);
+	bench(results[1], F("setVolume_elided"), callSetVolumeElided);
+	bench(results[2], F("setLevel"), callSetLevel);
+	bench(results[3], F("mute"), callMute);
+	bench(results[4], F("urgentMute"), callUrgentMute);
+	bench(results[5], F("init"), callInit);
+	bench(results[6], F("formatQuarterDb"), callFormatQuarterDb);
+	Muses.flush();
+
+	// the USART transport had the UART in SPI mode until now
+	Serial.begin(115200);
+	for (uint8_t i = 0; i < 7; i++)
+	{
+		print(results[i]);
+	}
+	Serial.println(F("bench end"));
+	Serial.flush();
+
+	// simavr exits when the core sleeps with interrupts off
+	cli();
+	SMCR = _BV(SE);
+	asm volatile("sleep");
+}
+
+void loop()
+{
+}
@@ -0,0 +1,53 @@
+#ifndef BAR_GRAPH_H
+#define BAR_GRAPH_H
+
+#include <Arduino.h>
+#include <FrameBuffer.h>
+#include <GlyphCache.h>
+
+/*
+Bar graphs across the 20 columns of a display row, 5 pixels per character
+for 100 positions. Partly filled cells use eight custom glyphs, filled from
+the left for bars growing to the right and from the right for bars growing
+to the left. Full and empty cells are the ROM block and space. The whole
+row is drawn into the framebuffer, its flush only sends the cells whose
+fill changed.
+*/
+class BarGraph
+{
+public:
+	static const uint8_t glyph_count = 8;
+	static const uint8_t cells = FrameBuffer::cols;
+	static const uint8_t cell_pixels = 5;
+	static const uint8_t pixels = cells * cell_pixels;
+
+	// glyphs 0 to 7, each 8 bytes in flash
+	static const uint8_t *const *glyphSet();
+
+	BarGraph();
+
+	// take slots for the glyphs before drawing, as many as the display
+	// has room for. call again until it returns true
+	template <class Display>
+	bool acquire(GlyphCache &cache, Display &display)
+	{
+		return cache.acquireSet(display, glyphSet(), glyph_count, slots);
+	}
+
+	// give the slots back once no bar is on screen
+	void release(GlyphCache &cache);
+
+	// bar of fill pixels (0 to pixels) from the left edge
+	void drawLevel(FrameBuffer &screen, uint8_t row, uint8_t fill);
+
+	// bar from the centre, offset pixels (-pixels / 2 to pixels / 2) to the
+	// right when positive, a thin mark at the centre when zero
+	void drawBalance(FrameBuffer &screen, uint8_t row, int8_t offset);
+
+private:
+	uint8_t cell(uint8_t fill, bool fromRight);
+
+	uint8_t slots[glyph_count]; // CGRAM slot of each glyph
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef BIG_NUMERALS_H
+#define BIG_NUMERALS_H
+
+#include <Arduino.h>
+#include <FrameBuffer.h>
+#include <GlyphCache.h>
+
+/*
+Big numerals, each digit 4 characters wide and 4 rows high, built from the
+eight custom glyphs in custom.h. The glyphs and digit maps stay in flash,
+acquire() gets CGRAM slots for the glyphs from the glyph cache, loading
+only those that are not resident already.
+*/
+class BigNumerals
+{
+public:
+	static const uint8_t digit_width = 4;
+	static const uint8_t max_digits = 5;
+
+	static const uint8_t glyph_count = 8;
+
+	// glyphs 0 to 7, each 8 bytes in flash
+	static const uint8_t *const *glyphSet();
+
+	// digits positions starting at column col, over all four rows
+	BigNumerals(uint8_t col, uint8_t digits);
+
+	// take slots for the glyphs before drawing, as many as the display
+	// has room for. call again until it returns true, the next draw()
+	// redraws every position
+	template <class Display>
+	bool acquire(GlyphCache &cache, Display &display)
+	{
+		invalidate();
+		return cache.acquireSet(display, glyphSet(), glyph_count, slots);
+	}
+
+	// give the slots back once the numerals are no longer on screen
+	void release(GlyphCache &cache);
+
+	// draw value right aligned with blank leading zeros, only the positions
+	// whose digit changed are redrawn
+	void draw(FrameBuffer &screen, uint16_t value);
+
+	// the area was drawn over, redraw every position next time
+	void invalidate();
+
+private:
+	void drawDigit(FrameBuffer &screen, uint8_t position, uint8_t digit);
+
+	uint8_t col;
+	uint8_t digits;
+	uint8_t shown[max_digits];		// digit drawn at each position
+	uint8_t slots[glyph_count];		// CGRAM slot of each glyph
+};
+
+#endif
@@ -0,0 +1,45 @@
+#include "DecibelText.h"
+
+static const uint16_t s_powers[] = {1000, 100, 10};
+static const char s_fractions[] = "00255075";
+
+uint8_t formatQuarterDb(char *text, int16_t quarters, uint8_t width) {
+  char digits[s_decibel_text_size - 1];
+  uint8_t n = 0;
+
+  uint16_t magnitude = quarters < 0 ? 0 - (uint16_t)quarters : quarters;
+  if (quarters < 0) {
+    digits[n++] = '-';
+  } else if (quarters > 0) {
+    digits[n++] = '+';
+  }
+
+  // at most 8192, four digits
+  uint16_t whole = magnitude >> 2;
+  bool leading = true;
+  for (uint8_t i = 0; i < sizeof(s_powers) / sizeof(s_powers[0]); i++) {
+    char digit = '0';
+    while (whole >= s_powers[i]) {
+      whole -= s_powers[i];
+      digit++;
+    }
+    if (digit != '0' || !leading) {
+      digits[n++] = digit;
+      leading = false;
+    }
+  }
+  digits[n++] = '0' + whole;
+  digits[n++] = '.';
+  digits[n++] = s_fractions[2 * (magnitude & 3)];
+  digits[n++] = s_fractions[2 * (magnitude & 3) + 1];
+
+  uint8_t pad = width > n ? width - n : 0;
+  for (uint8_t i = 0; i < pad; i++) {
+    text[i] = ' ';
+  }
+  for (uint8_t i = 0; i < n; i++) {
+    text[pad + i] = digits[i];
+  }
+  text[pad + n] = 0;
+  return pad + n;
+}
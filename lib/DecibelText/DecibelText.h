@@ -0,0 +1,24 @@
+/* Quarter dB text formatter
+****************************
+
+Formats a level in 0.25 dB steps as text, e.g. -95 as " -23.75", with
+integer arithmetic only. Digits come from repeated subtraction, at most
+nine rounds per digit and no division, so the worst case (-8192.00) is a
+fixed few hundred cycles. Nothing here pulls in float printing.
+
+*/
+
+#ifndef INCLUDED_DECIBEL_TEXT
+#define INCLUDED_DECIBEL_TEXT
+
+#include <stdint.h>
+
+// longest text, "-8192.00", plus the terminating zero
+static const uint8_t s_decibel_text_size = 9;
+
+// write quarters / 4 dB right aligned in width characters and terminate
+// it, text must hold max(width, 8) + 1 characters. positive levels get a
+// '+'. returns the number of characters written.
+uint8_t formatQuarterDb(char *text, int16_t quarters, uint8_t width = 7);
+
+#endif // INCLUDED_DECIBEL_TEXT
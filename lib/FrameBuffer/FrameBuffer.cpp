@@ -0,0 +1,55 @@
+#include "FrameBuffer.h"
+#include <string.h>
+
+typedef FrameBuffer Self;
+
+Self::FrameBuffer():
+  col(0),
+  row(0) {
+  memset(next, ' ', sizeof(next));
+  memset(shown, ' ', sizeof(shown));
+}
+
+void Self::setCursor(uint8_t col, uint8_t row) {
+  this->col = col;
+  this->row = min(row, (uint8_t)(rows - 1));
+}
+
+size_t Self::write(uint8_t value) {
+  if (col >= cols) {
+    return 0;
+  }
+  next[row][col++] = value;
+  return 1;
+}
+
+void Self::clear() {
+  memset(next, ' ', sizeof(next));
+  col = 0;
+  row = 0;
+}
+
+void Self::clearRow(uint8_t row) {
+  setCursor(0, row);
+  clearToEnd();
+  col = 0;
+}
+
+void Self::clearToEnd() {
+  if (col < cols) {
+    memset(&next[row][col], ' ', cols - col);
+  }
+}
+
+void Self::invalidate() {
+  // make every cell differ from what is drawn
+  for (uint8_t r = 0; r < rows; r++) {
+    for (uint8_t c = 0; c < cols; c++) {
+      shown[r][c] = ~next[r][c];
+    }
+  }
+}
+
+bool Self::dirty() const {
+  return memcmp(next, shown, sizeof(next)) != 0;
+}
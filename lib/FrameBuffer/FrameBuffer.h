@@ -0,0 +1,106 @@
+/* LCD shadow framebuffer
+*************************
+
+A RAM copy of the 20x4 character display. The UI draws into it with the
+usual Print functions, flush() then compares it with what the display shows
+and sends only the runs of cells that changed. Redrawing a whole line in RAM
+on every volume step therefore only puts the digits that changed on the bus.
+
+Drawing is clipped at the end of a line, nothing wraps.
+
+*/
+
+#ifndef INCLUDED_FRAME_BUFFER
+#define INCLUDED_FRAME_BUFFER
+
+#include <Arduino.h>
+#include <string.h>
+
+class FrameBuffer : public Print {
+  public:
+    static const uint8_t cols = 20;
+    static const uint8_t rows = 4;
+
+    // both copies start blank, like the display after init()
+    FrameBuffer();
+
+    void setCursor(uint8_t col, uint8_t row);
+    virtual size_t write(uint8_t value);
+    using Print::write;
+
+    void clear();
+    void clearRow(uint8_t row);
+
+    // fill from the cursor to the end of its line with spaces
+    void clearToEnd();
+
+    // the display contents are unknown, e.g. after lcd.clear() or a power
+    // glitch, redraw every cell on the next flush()
+    void invalidate();
+
+    bool dirty() const;
+
+    // send the changed cells, returns the number of characters written.
+    // Display needs setCursor(col, row), write(buffer, size) and room(), the
+    // number of cursor moves or characters it takes without waiting. what
+    // does not fit goes out on the next flush().
+    template <class Display>
+    uint8_t flush(Display &display);
+
+  private:
+    // unchanged cells up to this long between two changed runs are resent
+    // rather than paying for a cursor move, which costs as much as a cell
+    static const uint8_t s_merge_gap = 1;
+
+    uint8_t next[rows][cols];   // drawn by the UI
+    uint8_t shown[rows][cols];  // last sent to the display
+    uint8_t col;
+    uint8_t row;
+};
+
+template <class Display>
+uint8_t FrameBuffer::flush(Display &display) {
+  uint8_t sent = 0;
+  uint8_t room = display.room();
+  for (uint8_t r = 0; r < rows; r++) {
+    // display cursor column on this row, cols when it is somewhere else
+    uint8_t at = cols;
+    uint8_t c = 0;
+    while (c < cols) {
+      if (next[r][c] == shown[r][c]) {
+        c++;
+        continue;
+      }
+
+      // extend the run over changed cells and short unchanged gaps
+      uint8_t end = c + 1;
+      for (uint8_t i = end; i < cols && i <= end + s_merge_gap; i++) {
+        if (next[r][i] != shown[r][i]) {
+          end = i + 1;
+        }
+      }
+
+      if (at != c) {
+        if (room < 2) {
+          return sent;
+        }
+        display.setCursor(c, r);
+        room--;
+      }
+      // the run goes out in one write so the display can pack it
+      uint8_t count = end - c < room ? end - c : room;
+      display.write(&next[r][c], count);
+      memcpy(&shown[r][c], &next[r][c], count);
+      c += count;
+      sent += count;
+      room -= count;
+      if (!room) {
+        return sent;
+      }
+      at = end;
+    }
+  }
+  return sent;
+}
+
+#endif // INCLUDED_FRAME_BUFFER
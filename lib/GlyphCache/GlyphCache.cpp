@@ -0,0 +1,54 @@
+#include "GlyphCache.h"
+
+typedef GlyphCache Self;
+
+Self::GlyphCache():
+  clock(0),
+  loads(0) {
+  invalidate();
+}
+
+void Self::release(uint8_t slot) {
+  if (slot < slots && refs[slot]) {
+    refs[slot]--;
+  }
+}
+
+uint8_t Self::find(const uint8_t *glyph) const {
+  for (uint8_t slot = 0; slot < slots; slot++) {
+    if (resident[slot] == glyph) {
+      return slot;
+    }
+  }
+  return none;
+}
+
+void Self::invalidate() {
+  for (uint8_t slot = 0; slot < slots; slot++) {
+    resident[slot] = 0;
+    refs[slot] = 0;
+    stamp[slot] = 0;
+  }
+}
+
+// an empty slot, else the unreferenced one acquired longest ago
+uint8_t Self::victim() const {
+  uint8_t best = none;
+  uint8_t best_age = 0;
+  for (uint8_t slot = 0; slot < slots; slot++) {
+    if (refs[slot]) {
+      continue;
+    }
+    if (!resident[slot]) {
+      return slot;
+    }
+    // wraps like the clock, fine while fewer than 256 acquires separate
+    // the oldest from the newest
+    uint8_t age = clock - stamp[slot];
+    if (best == none || age > best_age) {
+      best = slot;
+      best_age = age;
+    }
+  }
+  return best;
+}
@@ -0,0 +1,112 @@
+/* CGRAM glyph cache
+********************
+
+Shares the eight HD44780 CGRAM slots between everything that draws custom
+glyphs. A glyph is identified by its 8 byte bitmap in flash. acquire()
+returns the slot already holding it, or loads it into a free slot or the
+least recently used slot nobody references. Glyphs with references are on
+screen and never evicted, reloading their slot would change every cell
+showing them.
+
+Switching screens back and forth therefore only reloads the glyphs the
+other screen pushed out, not the whole set. acquireSet() loads only as many
+glyphs as the display takes without waiting and is called again for the
+rest, so a screen switch never stalls on a full bus queue.
+
+*/
+
+#ifndef INCLUDED_GLYPH_CACHE
+#define INCLUDED_GLYPH_CACHE
+
+#include <Arduino.h>
+
+class GlyphCache {
+  public:
+    static const uint8_t slots = 8;
+    static const uint8_t none = 0xFF;
+
+    // display room() one glyph load takes: the CGRAM address and 8 rows
+    static const uint8_t load_room = 9;
+
+    GlyphCache();
+
+    // slot holding glyph (8 bytes in flash), loaded through the display
+    // if needed, with one more reference. none when every slot is in use.
+    template <class Display>
+    uint8_t acquire(Display &display, const uint8_t *glyph);
+
+    // acquire() count glyphs into slots[], the ones already resident
+    // first so loading the others cannot evict them. entries of slots[]
+    // other than none are kept from an earlier call. loads stop when the
+    // display has no room(), returns false until the set is complete
+    // (a glyph that got no slot counts as done).
+    template <class Display>
+    bool acquireSet(Display &display, const uint8_t *const *glyphs,
+                    uint8_t count, uint8_t *slots);
+
+    // drop a reference taken by acquire(), the glyph stays resident
+    void release(uint8_t slot);
+
+    // slot holding glyph, none if it is not loaded
+    uint8_t find(const uint8_t *glyph) const;
+
+    // forget every glyph and reference, e.g. after the display was reset
+    // and before anything is drawn again
+    void invalidate();
+
+    // glyphs written to CGRAM so far
+    uint16_t getLoads() const { return loads; }
+
+  private:
+    uint8_t victim() const;
+
+    const uint8_t *resident[slots];
+    uint8_t refs[slots];
+    uint8_t stamp[slots];   // clock at the last acquire
+    uint8_t clock;
+    uint16_t loads;
+};
+
+template <class Display>
+uint8_t GlyphCache::acquire(Display &display, const uint8_t *glyph) {
+  uint8_t slot = find(glyph);
+  if (slot == none) {
+    slot = victim();
+    if (slot == none) {
+      return none;
+    }
+    uint8_t bitmap[8];
+    memcpy_P(bitmap, glyph, sizeof(bitmap));
+    display.createChar(slot, bitmap);
+    resident[slot] = glyph;
+    loads++;
+  }
+  refs[slot]++;
+  stamp[slot] = ++clock;
+  return slot;
+}
+
+template <class Display>
+bool GlyphCache::acquireSet(Display &display, const uint8_t *const *glyphs,
+                            uint8_t count, uint8_t *slots) {
+  for (uint8_t i = 0; i < count; i++) {
+    if (slots[i] == none) {
+      slots[i] = find(glyphs[i]);
+      if (slots[i] != none) {
+        refs[slots[i]]++;
+        stamp[slots[i]] = ++clock;
+      }
+    }
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    if (slots[i] == none) {
+      if (display.room() < load_room) {
+        return false;
+      }
+      slots[i] = acquire(display, glyphs[i]);
+    }
+  }
+  return true;
+}
+
+#endif // INCLUDED_GLYPH_CACHE
@@ -0,0 +1,264 @@
+#include "Hd44780I2c.h"
+#include <TwiAsync.h>
+#include <util/atomic.h>
+
+typedef Hd44780I2c Self;
+
+// PCF8574 outputs
+static const uint8_t s_rs = _BV(0);
+static const uint8_t s_en = _BV(2);
+static const uint8_t s_backlight = _BV(3);
+
+// HD44780 instructions
+static const uint8_t s_clear = 0x01;
+static const uint8_t s_home = 0x02;
+static const uint8_t s_entry_left = 0x06;
+static const uint8_t s_display_control = 0x08;
+static const uint8_t s_display_on = 0x04;
+static const uint8_t s_function_4bit_2line = 0x28;
+static const uint8_t s_set_cgram = 0x40;
+static const uint8_t s_set_ddram = 0x80;
+
+// clear and home take 1.52ms, everything else 37us
+static const uint16_t s_slow_us = 2000;
+
+// expander writes for one instruction or character: RS set up, then EN
+// high and EN low for each nibble
+static const uint8_t s_pack_size = 5;
+
+// bytes of ring room() budgets per character or cursor move, a character
+// takes 4 and a cursor move also starts a new transaction
+static const uint8_t s_room_size = 6;
+
+static const uint8_t s_row_offset[] = {0x00, 0x40, 0x14, 0x54};
+
+Self::Hd44780I2c(uint8_t address, uint8_t cols, uint8_t rows,
+                 uint32_t frequency):
+  frequency(frequency),
+  address(address),
+  cols(cols),
+  rows(rows),
+  backlight_bit(s_backlight),
+  display_control(s_display_control | s_display_on),
+  rs(0),
+  queued_rs(0),
+  run_length(0),
+  draining(false),
+  since(0),
+  hold_us(0) {
+}
+
+void Self::begin() {
+  TwiAsync::begin(frequency);
+
+  // wait for the supply to come up, then reset into 4-bit mode (HD44780
+  // datasheet figure 24)
+  expanderWrite(0);
+  delay(50);
+  write4bits(0x30);
+  delayMicroseconds(4500);
+  write4bits(0x30);
+  delayMicroseconds(4500);
+  write4bits(0x30);
+  delayMicroseconds(150);
+  write4bits(0x20);
+
+  command(s_function_4bit_2line);
+  command(display_control);
+  command(s_entry_left);
+  clear();
+}
+
+void Self::clear() {
+  command(s_clear);
+  holdOff(s_slow_us);
+}
+
+void Self::home() {
+  command(s_home);
+  holdOff(s_slow_us);
+}
+
+void Self::setCursor(uint8_t col, uint8_t row) {
+  if (row >= rows) {
+    row = rows - 1;
+  }
+  pack(s_set_ddram | (col + s_row_offset[row]), 0);
+}
+
+size_t Self::write(uint8_t value) {
+  pack(value, s_rs);
+  sendRun();
+  return 1;
+}
+
+size_t Self::write(const uint8_t *buffer, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    pack(buffer[i], s_rs);
+  }
+  sendRun();
+  return size;
+}
+
+void Self::display() {
+  display_control |= s_display_on;
+  commandNow(display_control);
+}
+
+void Self::noDisplay() {
+  display_control &= ~s_display_on;
+  commandNow(display_control);
+}
+
+void Self::backlight() {
+  backlight_bit = s_backlight;
+  expanderWrite(queued_rs);
+}
+
+void Self::noBacklight() {
+  backlight_bit = 0;
+  expanderWrite(queued_rs);
+}
+
+void Self::createChar(uint8_t slot, const uint8_t glyph[8]) {
+  pack(s_set_cgram | ((slot & 7) << 3), 0);
+  for (uint8_t i = 0; i < 8; i++) {
+    pack(glyph[i], s_rs);
+  }
+  sendRun();
+}
+
+uint8_t Self::room() {
+  if (!ready()) {
+    return 0;
+  }
+  uint8_t space = TwiAsync::space();
+  return space > run_length ? (space - run_length) / s_room_size : 0;
+}
+
+void Self::command(uint8_t value) {
+  pack(value, 0);
+  sendRun();
+}
+
+bool Self::ready() {
+  if (draining) {
+    // the instruction reaches the controller with the last queued byte
+    if (!TwiAsync::idle()) {
+      return false;
+    }
+    draining = false;
+    since = micros();
+  }
+  if (micros() - since < hold_us) {
+    return false;
+  }
+  hold_us = 0;
+  return true;
+}
+
+// the controller is busy for us once everything queued so far is out.
+// other instructions take 37us, the next one is latched two bus bytes
+// later (45us at 400kHz) so they need no hold-off.
+void Self::holdOff(uint16_t us) {
+  draining = true;
+  hold_us = us;
+#ifdef HD44780_FIXED_DELAYS
+  waitReady();
+#endif
+}
+
+void Self::waitReady() {
+  if (draining) {
+    TwiAsync::flush();
+  }
+  while (!ready()) {
+  }
+}
+
+// append an instruction or character to the run
+void Self::pack(uint8_t value, uint8_t mode) {
+  if (run_length + s_pack_size > s_run_size) {
+    sendRun();
+  }
+  uint8_t high = (value & 0xF0) | mode | backlight_bit;
+  uint8_t low = (value << 4) | mode | backlight_bit;
+  // RS has to settle before EN rises, data only before EN falls
+  if (mode != rs) {
+    run[run_length++] = high;
+    rs = mode;
+  }
+  run[run_length++] = high | s_en;
+  run[run_length++] = high;
+  run[run_length++] = low | s_en;
+  run[run_length++] = low;
+}
+
+// queue the run as one I2C transaction
+void Self::sendRun() {
+  if (!run_length) {
+    return;
+  }
+  waitReady();
+  // with queued_rs updated in step, so commandNow() from an interrupt
+  // leaves RS as this run expects it. only the attempt is atomic, a full
+  // queue is waited out with interrupts enabled.
+  for (;;) {
+    bool queued;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      queued = TwiAsync::write(address, run, run_length);
+      if (queued) {
+        queued_rs = rs;
+      }
+    }
+    if (queued) {
+      break;
+    }
+    TwiAsync::waitStep();
+  }
+  run_length = 0;
+}
+
+// an instruction in its own transaction, ahead of any run being built.
+// RS is put back afterwards so the run still finds it as it left it. it
+// does not wait out a hold-off, the controller ignores it during a clear.
+void Self::commandNow(uint8_t value) {
+  uint8_t bytes[6];
+  uint8_t high = (value & 0xF0) | backlight_bit;
+  uint8_t low = (value << 4) | backlight_bit;
+  bytes[0] = high;
+  bytes[1] = high | s_en;
+  bytes[2] = high;
+  bytes[3] = low | s_en;
+  bytes[4] = low;
+  for (;;) {
+    bool queued;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      // RS as left by the last queued run, read together with queueing
+      bytes[5] = low | queued_rs;
+      queued = TwiAsync::write(address, bytes, sizeof(bytes));
+    }
+    if (queued) {
+      return;
+    }
+    TwiAsync::waitStep();
+  }
+}
+
+// a single nibble, only used while the controller is still in 8-bit mode
+void Self::write4bits(uint8_t value) {
+  uint8_t bytes[3];
+  bytes[0] = value | backlight_bit;
+  bytes[1] = value | backlight_bit | s_en;
+  bytes[2] = value | backlight_bit;
+  TwiAsync::writeWait(address, bytes, sizeof(bytes));
+  TwiAsync::flush();
+  rs = 0;
+  queued_rs = 0;
+}
+
+// set the expander outputs with EN low, e.g. for the backlight
+void Self::expanderWrite(uint8_t value) {
+  uint8_t data = value | backlight_bit;
+  TwiAsync::writeWait(address, &data, 1);
+}
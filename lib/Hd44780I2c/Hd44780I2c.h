@@ -0,0 +1,107 @@
+/* HD44780 display on a PCF8574 I2C backpack
+********************************************
+
+Drives the usual 20x4 LCD module with a PCF8574 backpack through TwiAsync,
+so output is queued and sent from the TWI interrupt instead of stalling the
+caller. Pin mapping as LiquidCrystal_I2C: P0 RS, P1 RW, P2 EN, P3 backlight,
+P4..P7 D4..D7.
+
+The expander states for a cursor move and the run of characters after it
+are packed into one I2C transaction. Each nibble takes two expander writes
+(data with EN high, then EN low), RS is set up with an extra write only
+when it changes.
+
+Bus cost per character, rewriting a 20 character line (bytes counted on a
+replay of the driver, times from the bit count at the bus clock):
+
+  driver                          bytes/char  transactions  100kHz   400kHz
+  LiquidCrystal_I2C + Wire        12          6 per char    ~1300us  -
+  one transaction per character   7           1 per char    ~650us   ~165us
+  packed runs                     4.3         1 per run     ~390us   ~100us
+
+LiquidCrystal_I2C also blocks for all of it and adds 100us of delays.
+
+Writes wait only when the TWI queue is full, room() tells how many
+characters or cursor moves fit without waiting. begin() blocks.
+
+clear() and home() take the controller 1.52ms. Instead of waiting that out
+they start a hold-off, counted from when the TWI queue has drained, and
+return. The next write waits for what is left of it, room() returns 0
+until then so a framebuffer flush simply comes back later. Build with
+HD44780_FIXED_DELAYS to wait in clear() and home() as before.
+
+display(), noDisplay(), backlight() and noBacklight() bypass the run and
+may be called from interrupts.
+
+*/
+
+#ifndef INCLUDED_HD44780_I2C
+#define INCLUDED_HD44780_I2C
+
+#include <Arduino.h>
+
+class Hd44780I2c : public Print {
+  public:
+    // the PCF8574 is rated for a 100kHz I2C clock, many modules run at
+    // 400kHz
+    Hd44780I2c(uint8_t address, uint8_t cols, uint8_t rows,
+               uint32_t frequency = 100000);
+
+    // reset the controller into 4-bit mode, clear it and switch it on
+    void begin();
+
+    void clear();
+    void home();
+
+    // the move is sent together with the characters written next
+    void setCursor(uint8_t col, uint8_t row);
+
+    virtual size_t write(uint8_t value);
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    using Print::write;
+
+    void display();
+    void noDisplay();
+    void backlight();
+    void noBacklight();
+
+    // load a 5x8 glyph into CGRAM slot 0..7, the cursor position is lost
+    void createChar(uint8_t slot, const uint8_t glyph[8]);
+
+    // characters or cursor moves that can be queued without waiting,
+    // 0 during a hold-off
+    uint8_t room();
+
+    void command(uint8_t value);
+
+    // true once the controller takes the next instruction
+    bool ready();
+
+  private:
+    // expander writes packed into one transaction, at most
+    static const uint8_t s_run_size = 48;
+
+    void pack(uint8_t value, uint8_t mode);
+    void sendRun();
+    void commandNow(uint8_t value);
+    void holdOff(uint16_t us);
+    void waitReady();
+    void write4bits(uint8_t value);
+    void expanderWrite(uint8_t value);
+
+    uint32_t frequency;
+    uint8_t address;
+    uint8_t cols;
+    uint8_t rows;
+    uint8_t backlight_bit;
+    uint8_t display_control;
+    uint8_t rs;          // RS at the end of the run
+    volatile uint8_t queued_rs; // RS at the end of the queued transactions
+    uint8_t run[s_run_size];
+    uint8_t run_length;
+    bool draining;       // hold-off starts once the TWI queue is empty
+    uint32_t since;      // micros() at the start of the hold-off
+    uint16_t hold_us;
+};
+
+#endif // INCLUDED_HD44780_I2C
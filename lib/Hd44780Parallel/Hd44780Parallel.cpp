@@ -0,0 +1,220 @@
+#include "Hd44780Parallel.h"
+#include <util/atomic.h>
+
+typedef Hd44780Parallel Self;
+
+// HD44780 instructions
+static const uint8_t s_clear = 0x01;
+static const uint8_t s_home = 0x02;
+static const uint8_t s_entry_left = 0x06;
+static const uint8_t s_display_control = 0x08;
+static const uint8_t s_display_on = 0x04;
+static const uint8_t s_function_4bit_2line = 0x28;
+static const uint8_t s_set_cgram = 0x40;
+static const uint8_t s_set_ddram = 0x80;
+
+// clear and home take 1.52ms, everything else 37us, with some margin for
+// a slow oscillator
+static const uint16_t s_slow_us = 2000;
+static const uint8_t s_exec_us = 40;
+
+static const uint8_t s_row_offset[] = {0x00, 0x40, 0x14, 0x54};
+
+Self::Hd44780Parallel(uint8_t rs, uint8_t en, uint8_t d4, uint8_t d5,
+                      uint8_t d6, uint8_t d7, uint8_t cols, uint8_t rows,
+                      uint8_t backlight):
+  cols(cols),
+  rows(rows),
+  display_control(s_display_control | s_display_on),
+  since(0),
+  hold_us(0) {
+  pins[0] = rs;
+  pins[1] = en;
+  pins[2] = d4;
+  pins[3] = d5;
+  pins[4] = d6;
+  pins[5] = d7;
+  pins[6] = backlight;
+}
+
+void Self::begin() {
+  attach(rs, pins[0]);
+  attach(en, pins[1]);
+  for (uint8_t i = 0; i < 4; i++) {
+    attach(data[i], pins[2 + i]);
+  }
+  attach(light, pins[6]);
+
+  // wait for the supply to come up, then reset into 4-bit mode (HD44780
+  // datasheet figure 24)
+  delay(50);
+  write4bits(0x03);
+  delayMicroseconds(4500);
+  write4bits(0x03);
+  delayMicroseconds(4500);
+  write4bits(0x03);
+  delayMicroseconds(150);
+  write4bits(0x02);
+  delayMicroseconds(s_exec_us);
+
+  command(s_function_4bit_2line);
+  command(display_control);
+  command(s_entry_left);
+  clear();
+}
+
+void Self::clear() {
+  command(s_clear);
+  holdOff(s_slow_us);
+}
+
+void Self::home() {
+  command(s_home);
+  holdOff(s_slow_us);
+}
+
+void Self::setCursor(uint8_t col, uint8_t row) {
+  if (row >= rows) {
+    row = rows - 1;
+  }
+  command(s_set_ddram | (col + s_row_offset[row]));
+}
+
+size_t Self::write(uint8_t value) {
+  send(value, true);
+  return 1;
+}
+
+size_t Self::write(const uint8_t *buffer, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    send(buffer[i], true);
+  }
+  return size;
+}
+
+void Self::display() {
+  display_control |= s_display_on;
+  commandNow(display_control);
+}
+
+void Self::noDisplay() {
+  display_control &= ~s_display_on;
+  commandNow(display_control);
+}
+
+void Self::backlight() {
+  set(light, true);
+}
+
+void Self::noBacklight() {
+  set(light, false);
+}
+
+void Self::createChar(uint8_t slot, const uint8_t glyph[8]) {
+  command(s_set_cgram | ((slot & 7) << 3));
+  for (uint8_t i = 0; i < 8; i++) {
+    send(glyph[i], true);
+  }
+}
+
+void Self::command(uint8_t value) {
+  send(value, false);
+}
+
+uint8_t Self::room() {
+  return ready() ? s_room : 0;
+}
+
+bool Self::ready() {
+  if (micros() - since < hold_us) {
+    return false;
+  }
+  hold_us = 0;
+  return true;
+}
+
+// the controller is busy for us from now on
+void Self::holdOff(uint16_t us) {
+  since = micros();
+  hold_us = us;
+#ifdef HD44780_FIXED_DELAYS
+  waitReady();
+#endif
+}
+
+void Self::waitReady() {
+  while (!ready()) {
+  }
+}
+
+void Self::attach(Pin &pin, uint8_t number) {
+  if (number == no_pin) {
+    pin.port = 0;
+    pin.mask = 0;
+    return;
+  }
+  pinMode(number, OUTPUT);
+  pin.port = portOutputRegister(digitalPinToPort(number));
+  pin.mask = digitalPinToBitMask(number);
+  set(pin, false);
+}
+
+// an instruction or character once the last one has executed. the caller
+// carries on while the controller executes it.
+void Self::send(uint8_t value, bool data) {
+  waitReady();
+  transfer(value, data);
+  holdOff(s_exec_us);
+}
+
+// an instruction from an interrupt, which may have arrived while the
+// controller was still executing a byte of the main loop. micros() does
+// not advance with interrupts disabled, the rest of the hold-off is
+// delayed out instead, and the hold-off of the main loop is left alone.
+void Self::commandNow(uint8_t value) {
+  uint32_t elapsed = micros() - since;
+  if (elapsed < hold_us) {
+    delayMicroseconds(hold_us - elapsed);
+  }
+  transfer(value, false);
+  delayMicroseconds(s_exec_us);
+}
+
+// both nibbles, an interrupt cannot split the byte so the nibble order
+// stays in step
+void Self::transfer(uint8_t value, bool data) {
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    set(rs, data);
+    write4bits(value >> 4);
+    write4bits(value);
+  }
+}
+
+void Self::write4bits(uint8_t value) {
+  for (uint8_t i = 0; i < 4; i++) {
+    set(data[i], value & (1 << i));
+  }
+  pulse();
+}
+
+// EN high for at least 450ns, data is taken on the falling edge
+void Self::pulse() {
+  set(en, true);
+  delayMicroseconds(1);
+  set(en, false);
+}
+
+// with interrupts disabled, another pin of the port may be written from
+// an interrupt
+void Self::set(const Pin &pin, bool high) {
+  if (!pin.port) {
+    return;
+  }
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if (high) {
+      *pin.port |= pin.mask;
+    } else {
+      *pin.port &= ~pin.mask;
+    }
+  }
+}
@@ -0,0 +1,97 @@
+/* HD44780 display on GPIO pins
+*******************************
+
+Drives the 20x4 LCD module directly in 4-bit mode: RS, EN and D4..D7 on
+any digital pins, R/W tied low, the backlight optionally switched by a pin.
+Same interface as Hd44780I2c, so the UI renders identically on either.
+
+Pins are written through their port registers, a character costs two EN
+pulses (~3us) plus the 37us the controller needs to execute it, against
+~390us of I2C traffic on the PCF8574 backpack at 100kHz. room() caps a
+flush at s_room characters so loop() is never held for more than ~0.7ms.
+
+R/W is not wired, so the busy flag cannot be read. Each instruction starts
+a hold-off of its execution time instead (37us, 1.52ms for clear and home)
+and only the next write waits for what is left of it. clear() returns at
+once and room() is 0 until the controller is ready. Build with
+HD44780_FIXED_DELAYS to wait out every hold-off straight away.
+
+display(), noDisplay(), backlight() and noBacklight() may be called from
+interrupts.
+
+*/
+
+#ifndef INCLUDED_HD44780_PARALLEL
+#define INCLUDED_HD44780_PARALLEL
+
+#include <Arduino.h>
+
+class Hd44780Parallel : public Print {
+  public:
+    static const uint8_t no_pin = 0xFF;
+
+    Hd44780Parallel(uint8_t rs, uint8_t en, uint8_t d4, uint8_t d5,
+                    uint8_t d6, uint8_t d7, uint8_t cols, uint8_t rows,
+                    uint8_t backlight = no_pin);
+
+    // set up the pins, reset the controller into 4-bit mode, clear it and
+    // switch it on
+    void begin();
+
+    void clear();
+    void home();
+
+    void setCursor(uint8_t col, uint8_t row);
+
+    virtual size_t write(uint8_t value);
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    using Print::write;
+
+    void display();
+    void noDisplay();
+    void backlight();
+    void noBacklight();
+
+    // load a 5x8 glyph into CGRAM slot 0..7, the cursor position is lost
+    void createChar(uint8_t slot, const uint8_t glyph[8]);
+
+    // characters or cursor moves to send per flush, 0 during a hold-off
+    uint8_t room();
+
+    void command(uint8_t value);
+
+    // true once the controller takes the next instruction
+    bool ready();
+
+  private:
+    static const uint8_t s_room = 16;
+
+    // one output pin, resolved to its port once
+    struct Pin {
+      volatile uint8_t *port;
+      uint8_t mask;
+    };
+
+    void attach(Pin &pin, uint8_t number);
+    void send(uint8_t value, bool data);
+    void commandNow(uint8_t value);
+    void transfer(uint8_t value, bool data);
+    void holdOff(uint16_t us);
+    void waitReady();
+    void write4bits(uint8_t value);
+    void pulse();
+    static void set(const Pin &pin, bool high);
+
+    uint8_t pins[7];     // RS, EN, D4..D7, backlight as given
+    Pin rs;
+    Pin en;
+    Pin data[4];
+    Pin light;
+    uint8_t cols;
+    uint8_t rows;
+    uint8_t display_control;
+    uint32_t since;      // micros() at the start of the hold-off
+    uint16_t hold_us;
+};
+
+#endif // INCLUDED_HD44780_PARALLEL
@@ -22,140 +22,84 @@
 */
 
 #include "Muses72323.h"
-#include <SPI.h>
 
-typedef Muses72323 Self;
+// the transports are AVR only, host builds use the mock or the model
+#ifdef __AVR__
+#include "Muses72323Transport.h"
 
-// pass through some types into global scope
-using data_t = Self::data_t;
-using volume_t = Self::volume_t;
-using pin_t = Self::pin_t;
+void (*volatile muses72323_spi_isr)();
 
-// control select addresses, chip address (low 4) ignored
-static const data_t s_control_attenuation_l = 0b0000000000010000;
-static const data_t s_control_attenuation_r = 0b0000000000010100;
-static const data_t s_control_gain          = 0b0000000000001000;
-static const data_t s_control_states        = 0b0000001000001100;
-
-// control state bits
-static const data_t s_state_soft_step         = 4;
-static const data_t s_state_bit_zero_crossing = 8;
-static const data_t s_state_external_clock    = 9;
-static const data_t s_state_bit_gain          = 15;
-
-pin_t _latch;
-// Muses72323 max clock freq=1MHz, set for 800KHz
-static const SPISettings s_muses_spi_settings(800000, MSBFIRST, SPI_MODE0);
-
-static inline data_t volume_to_attenuation(volume_t volume)
+ISR(SPI_STC_vect)
 {
-  volume_t tmp ;
-  tmp = 4096  + (-volume * 128) ;
-  // volume to attenuation data conversion:
-  // #=====================================#
-  // |    0.0 dB | in: [  0] -> 0b000100000 |
-  // | -117.5 dB | in: [447] -> 0b111011111 |
-  // #=====================================#
-  return static_cast<data_t>(tmp);
+  muses72323_spi_isr();
 }
-/*
-  static inline data_t volume_to_gain(volume_t gain)
-  {
-  // volume to gain data conversion:
-  // #===================================#
-  // |     0 dB | in: [ 0] -> 0b00000000 |
-  // | +31.5 dB | in: [63] -> 0b01111111 |
-  // #===================================#
-  return static_cast<data_t>(min(gain, 63));
+#endif
+
+#ifdef MUSES72323_TRACE
+// one record per register write, (timestamp, address, data)
+struct trace_entry_t {
+  uint32_t time;
+  word address;
+  word data;
+};
+
+static trace_entry_t s_trace[MUSES72323_TRACE_SIZE];
+static volatile uint8_t s_trace_head;
+static volatile uint8_t s_trace_tail;
+static volatile uint8_t s_trace_count;
+static volatile uint8_t s_trace_dropped;  // records lost since last drained
+
+void muses72323_trace_record(uint16_t address, uint16_t data)
+{
+  uint32_t now = micros();
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if (s_trace_count == MUSES72323_TRACE_SIZE) {
+      // keep the oldest records, the drain reports how many were lost
+      if (s_trace_dropped < 255) {
+        s_trace_dropped++;
+      }
+      return;
+    }
+    trace_entry_t &entry = s_trace[s_trace_head];
+    entry.time = now;
+    entry.address = address;
+    entry.data = data;
+    s_trace_head = (s_trace_head + 1) % MUSES72323_TRACE_SIZE;
+    s_trace_count++;
   }
-*/
-
-Self::Muses72323(address_t chip_address, pin_t latch):
-  chip_address(chip_address & 0b0000000000000011),
-  states(0) {
-  _latch = latch;
 }
 
-void Self::begin() {
-  pinMode(_latch, OUTPUT);
-  digitalWrite(_latch, HIGH);
-  SPI.begin();
-  //  SPI.setBitOrder(MSBFIRST);
-  //  SPI.setDataMode(SPI_MODE2);
-  //  initialize SPI:
-  //  SPI.setClockDivider(SPI_CLOCK_DIV64);
-}
-
-void Self::setVolume(volume_t lch, volume_t rch) {
-  transfer(s_control_attenuation_l, volume_to_attenuation(lch));
-  transfer(s_control_attenuation_r, volume_to_attenuation(rch));
-}
-
-void Self::setGain() {
-  transfer(s_control_gain, gain);
-}
-
-void Self::mute() {
-  transfer(s_control_attenuation_l, 0);
-  transfer(s_control_attenuation_r, 0);
-}
-
-void Self::setExternalClock(bool enabled) {
-  // 0 external, 1 internal
-  bitWrite(states, s_state_external_clock, !enabled);
-  transfer(s_control_states, states);
-}
-
-void Self::setZeroCrossingOn(bool enabled) {
-  // 0 is enabled, 1 is disabled
-  bitWrite(gain, s_state_bit_zero_crossing, !enabled);
-  transfer(s_control_gain, gain);
-}
-
-void Self::setLinkChannels(bool enabled) {
-  // 1 is enabled (linked channels), 0 is disabled
-  bitWrite(gain, s_state_bit_gain, enabled);
-  transfer(s_control_gain, gain);
+uint8_t muses72323_trace_available()
+{
+  return s_trace_count;
 }
 
-void Self::transfer(address_t address, data_t data) {
-  word tmp ;
-  tmp = address | chip_address ;
-  tmp = tmp | data ;
-
-  
-    // for debug
-    for (int i = 15; i>=0;i--) {
-     Serial.print(bitRead(chip_address,i));
-    if (i==7) Serial.print(" ");
-    }
-    Serial.print("\t");
-
-    for (int i = 15; i>=0;i--) {
-    Serial.print(bitRead(address,i));
-    if (i==7) Serial.print(" ");
-    }
-    Serial.print("\t");
-
-    for (int i = 15; i>=0;i--) {
-    Serial.print(bitRead(data,i));
-    if (i==7) Serial.print(" ");
-    }
-    Serial.print("\t");
-
-    for (int i = 15; i>=0;i--)  {
-    Serial.print(bitRead(tmp,i));
-    if (i==7) Serial.print(" ");
+uint8_t muses72323_trace_drain(Print &out, uint8_t max)
+{
+  uint8_t sent = 0;
+  while (sent < max && s_trace_count) {
+    trace_entry_t entry;
+    uint8_t dropped;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      entry = s_trace[s_trace_tail];
+      dropped = s_trace_dropped;
+      s_trace_dropped = 0;
+      s_trace_tail = (s_trace_tail + 1) % MUSES72323_TRACE_SIZE;
+      s_trace_count--;
     }
-    Serial.print("\n");
-  
-
-  SPI.beginTransaction(s_muses_spi_settings);
-  digitalWrite(_latch, LOW);
-
-  SPI.transfer(highByte(tmp));
-  SPI.transfer(lowByte(tmp));
-
-  digitalWrite(_latch, HIGH);
-  SPI.endTransaction();
+    // frame layout (little endian), decoded by tools/muses_trace.py:
+    // 0xA5, dropped, time[4], address[2], data[2]
+    uint8_t frame[] = {
+      0xA5,
+      dropped,
+      (uint8_t)(entry.time), (uint8_t)(entry.time >> 8),
+      (uint8_t)(entry.time >> 16), (uint8_t)(entry.time >> 24),
+      lowByte(entry.address), highByte(entry.address),
+      lowByte(entry.data), highByte(entry.data)
+    };
+    out.write(frame, sizeof(frame));
+    sent++;
+  }
+  return sent;
 }
+#endif
@@ -24,8 +24,111 @@
 #ifndef INCLUDED_MUSES_72323
 #define INCLUDED_MUSES_72323
 
+#include <stdint.h>
+#include "Muses72323Levels.h"
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#else
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#endif
+
+// build with -D MUSES72323_TRACE to record every register write sent to the
+// chip into a RAM ring buffer, drained as binary frames with traceDrain()
+#if defined(MUSES72323_TRACE) && !defined(MUSES72323_TRACE_SIZE)
+#define MUSES72323_TRACE_SIZE 16
+#endif
+
+#ifdef MUSES72323_TRACE
 #include <Arduino.h>
 
+// trace storage is shared by all chips, see Muses72323.cpp
+void muses72323_trace_record(uint16_t address, uint16_t data);
+uint8_t muses72323_trace_available();
+uint8_t muses72323_trace_drain(Print &out, uint8_t max);
+#endif
+
+namespace muses72323 {
+  // control select addresses, chip address (low 2) ignored
+  static const uint16_t s_control_attenuation_l = 0b0000000000010000;
+  static const uint16_t s_control_attenuation_r = 0b0000000000010100;
+  static const uint16_t s_control_gain          = 0b0000000000001000;
+  static const uint16_t s_control_states        = 0b0000001000001100;
+  // select address bits of a frame
+  static const uint16_t s_select_mask           = 0b0000000000011100;
+
+  // control state bits
+  // soft step enable, bit 4 in the MUSES72320 layout overlaps the select
+  // address (D4..D2) here so it sits in the first data bit instead
+  static const uint8_t s_state_soft_step         = 5;
+  // soft step clock divider, 3 bits at D8..D6
+  static const uint8_t s_state_soft_step_divider = 6;
+  static const uint8_t s_state_bit_zero_crossing = 8;
+  static const uint8_t s_state_external_clock    = 9;
+  static const uint8_t s_state_bit_gain          = 15;
+
+  // gain code, 0..63 in 0.5 dB steps at D14..D9 of the gain register
+  static const uint16_t s_gain_mask = 0b0111111000000000;
+
+  static inline void write_bit(uint16_t &value, uint8_t bit, bool set)
+  {
+    if (set) {
+      value |= (uint16_t)1 << bit;
+    } else {
+      value &= ~((uint16_t)1 << bit);
+    }
+  }
+
+  static inline int clamp_level(int level, int high)
+  {
+    return level < s_level_min ? s_level_min : level > high ? high : level;
+  }
+
+  // keeps interrupts off for its lifetime, restoring the previous state
+  struct interrupt_guard {
+#ifdef __AVR__
+    uint8_t sreg;
+    interrupt_guard(): sreg(SREG) { cli(); }
+    ~interrupt_guard() { SREG = sreg; }
+#else
+    interrupt_guard() {}
+    ~interrupt_guard() {}
+#endif
+  };
+
+  // soft step model: time per 0.25 dB step with divider 0, each divider
+  // increment doubles it. the chip counts the step clock internally, so
+  // this is a model to be calibrated against a scope trace.
+  static const uint16_t s_soft_step_base_us = 64;
+
+  // attenuation steps between two attenuation register values. mute (0)
+  // counts as one step below -111.75 dB
+  static inline uint16_t attenuation_steps(uint16_t from, uint16_t to)
+  {
+    uint16_t a = from ? from >> 7 : 480;
+    uint16_t b = to ? to >> 7 : 480;
+    return a > b ? a - b : b - a;
+  }
+}
+
+// Transport is a policy class (see Muses72323Transport.h) providing
+//   static const uint8_t frame_us;  // nominal bus time per word
+//   static void begin();
+//   static void send(uint16_t frame);
+//   static void beginBurst();
+//   static void endBurst();
+//   static void discard();    // drop queued words not yet started
+//   static void setAsync(bool enabled);
+//   static bool isAsync();    // send() only queues the word, atomically
+//   static bool idle();
+//   static void flush();
+//   static uint32_t now();    // microseconds
+// the latch pin is part of the transport, so with a constant chip address
+// the whole write path inlines into the callers.
+template <class Transport>
 class Muses72323 {
   public:
     // contextual data types
@@ -33,9 +136,10 @@ class Muses72323 {
     typedef uint16_t data_t;
     typedef int volume_t;
     typedef uint16_t address_t;
+    typedef Transport transport_t;
 
-    // specify a connection over an address using three output pins
-    Muses72323(address_t chip_address, pin_t latch);
+    // specify a chip by the address wired into its ADR pins
+    explicit Muses72323(address_t chip_address);
 
     // set the pins in their correct states
     void begin();
@@ -44,12 +148,49 @@ class Muses72323 {
     // (-0.25 * volume) db
     // audio level goes from -111.75 to 0.0 dB
     // input goes from -447 to 0
+    // the attenuation words, including the per-channel trim, come from the
+    // generated table in Muses72323Levels.cpp
     void setVolume(volume_t left, volume_t right);
 
+    // set the level using the gain stage as well as the attenuator:
+    // (0.25 * level) dB, from -111.75 to +31.5 dB, input goes from -447
+    // to 126. the split between gain and attenuation comes from the
+    // generated table in Muses72323Levels.cpp. the gain stage is shared,
+    // so it is planned for the louder channel.
+    void setLevel(volume_t left, volume_t right);
+
     // gain is disabled, this function sets the settings in the gain address
     void setGain();
 
     void mute();
+
+    // mute from interrupt context, e.g. on power failure. soft step is
+    // switched off until unmute() so the mute is immediate. anything still staged or
+    // queued is dropped and the shadow registers are invalidated, as the
+    // dropped writes never reached the chip. in async mode the mute is
+    // queued at once, and queued again behind a frame the main loop was
+    // pushing. a blocking transport halfway through a frame cannot be
+    // interrupted, the mute is then deferred until the ISR has returned and
+    // that frame is latched, and the ISR returns in a few cycles.
+    // the mute holds: attenuation and gain writes are dropped, including
+    // the rest of a setter the interrupt cut short, until unmute() or the
+    // next beginCommit().
+    void urgentMute();
+
+    // release an urgentMute(), switching soft step back on if it was and
+    // resending the gain register so the chip matches the driver again.
+    // the levels stay muted until the next setter. does nothing when no
+    // urgent mute is held.
+    void unmute();
+
+    // group register writes into one unit. setters called between
+    // beginCommit() and commit() are staged and then sent back to back,
+    // with no other frame in between. an urgentMute() arriving meanwhile
+    // is applied at the next frame boundary and cancels the rest.
+    // more than commit_size writes are committed in batches.
+    static const uint8_t commit_size = 8;
+    void beginCommit();
+    void commit();
     // must be set to false if no external clock is connected
     void setExternalClock(bool enabled);
 
@@ -60,13 +201,471 @@ class Muses72323 {
     // to set attenuation with linked channels just set the left channel
     void setLinkChannels(bool enabled);
 
+    // when enabled the chip is switched into linked mode whenever left and
+    // right are set to the same level, so only the left word is sent, and
+    // back to independent channels when they differ (balance, trim)
+    void setAutoLink(bool enabled) { auto_link = enabled; }
+
+    // with soft step enabled the chip ramps each attenuation change in
+    // 0.25 dB steps instead of jumping, so a single write of the target
+    // level is click free. divider (0..7) slows the ramp, see
+    // getSoftStepPeriod()
+    void setSoftStep(bool enabled, uint8_t divider = 0);
+
+    // modelled time per 0.25 dB step in microseconds, 0 when soft step is off
+    uint16_t getSoftStepPeriod() const;
+
+    // modelled time in microseconds until the output reaches the level of
+    // the last attenuation write, 0 once it has settled
+    uint32_t getSettleTime() const;
+    bool settled() const { return getSettleTime() == 0; }
+
+    // the chip cannot be read back, so a register corrupted by a bus glitch
+    // or brown-out would go unnoticed. scrub() re-sends one shadowed
+    // register, round robin, at most once per interval (0 disables).
+    // call it from idle loop time, it does nothing while writes are pending.
+    void setScrubInterval(uint16_t milliseconds) { scrub_interval = milliseconds; }
+
+    // returns true when a scrub write went out
+    bool scrub();
+
+    // number of scrub writes sent, not included in getIssuedTransfers()
+    uint32_t getScrubWrites() const { return scrub_writes; }
+
+    // when enabled, register writes are queued and shifted out from the SPI
+    // interrupt so the caller does not wait for the bus. disabling flushes
+    // the queue first. transports without interrupt support ignore this.
+    void setAsync(bool enabled) { Transport::setAsync(enabled); }
+
+    // true when no queued writes are pending or in flight
+    bool idle() const { return Transport::idle(); }
+
+    // wait until every queued write has been latched by the chip. safe to
+    // call with interrupts disabled, the queue is then serviced by polling.
+    void flush() { Transport::flush(); }
+
+    // forget the shadow registers so the next write to each one is sent,
+    // e.g. after the chip has been power cycled
+    void invalidate() { shadow_valid = 0; }
+
+    // number of register writes sent to the chip and number skipped because
+    // the shadow register already held the value
+    uint32_t getIssuedTransfers() const { return transfers_issued; }
+    uint32_t getElidedTransfers() const { return transfers_elided; }
+    void resetTransferCounters();
+
+#ifdef MUSES72323_TRACE
+    // bytes written per trace record by traceDrain()
+    static const uint8_t trace_frame_size = 10;
+
+    // number of trace records waiting to be drained
+    uint8_t traceAvailable() const { return muses72323_trace_available(); }
+
+    // write up to max pending trace records to out, returns the number sent.
+    // use tools/muses_trace.py on the host to decode them.
+    uint8_t traceDrain(Print &out, uint8_t max = 255) {
+      return muses72323_trace_drain(out, max);
+    }
+#endif
+
   private:
+    // write-only registers mirrored in the shadow cache
+    enum register_t {
+      reg_attenuation_l,
+      reg_attenuation_r,
+      reg_gain,
+      reg_states,
+      reg_count
+    };
+
+    static address_t control_address(register_t reg) {
+      return reg == reg_attenuation_l ? muses72323::s_control_attenuation_l :
+             reg == reg_attenuation_r ? muses72323::s_control_attenuation_r :
+             reg == reg_gain ? muses72323::s_control_gain :
+             muses72323::s_control_states;
+    }
+
+    void writeAttenuation(data_t left, data_t right);
+    void write(register_t reg, data_t data);
     void transfer(address_t address, data_t data);
+    void sendFrame(data_t frame);
+    void applyUrgentMute();
 
     // for multiple chips on the same bus line
     address_t chip_address;
     data_t states ;
     data_t gain ;
+
+    // last value written to each register, valid when its bit is set
+    data_t shadow[reg_count];
+    uint8_t shadow_valid;
+
+    uint32_t transfers_issued;
+    uint32_t transfers_elided;
+
+    // end of the modelled soft step ramp, in Transport::now() time
+    uint32_t ramp_end;
+
+    bool auto_link;
+
+    uint16_t scrub_interval;
+    uint8_t scrub_next;      // register to scrub next
+    uint32_t scrub_last;     // Transport::now() of the last scrub write
+    uint32_t scrub_writes;
+
+    // frames staged by beginCommit()
+    bool staging;
+    uint8_t staged_count;
+    data_t staged[commit_size];
+
+    volatile bool in_frame;      // main loop is sending a frame
+    volatile bool mute_pending;  // urgentMute() deferred to frame boundary
+    volatile bool cancel_staged; // urgentMute() since beginCommit()
+    volatile bool held;          // urgentMute() until unmute()
+    bool resume_soft_step;       // soft step state for unmute()
 };
 
+template <class Transport>
+Muses72323<Transport>::Muses72323(address_t chip_address):
+  chip_address(chip_address & 0b0000000000000011),
+  states(0),
+  gain(0),
+  shadow_valid(0),
+  transfers_issued(0),
+  transfers_elided(0),
+  ramp_end(0),
+  auto_link(false),
+  scrub_interval(0),
+  scrub_next(0),
+  scrub_last(0),
+  scrub_writes(0),
+  staging(false),
+  staged_count(0),
+  in_frame(false),
+  mute_pending(false),
+  cancel_staged(false),
+  held(false),
+  resume_soft_step(false) {
+}
+
+template <class Transport>
+void Muses72323<Transport>::begin() {
+  Transport::begin();
+}
+
+template <class Transport>
+void Muses72323<Transport>::setVolume(volume_t lch, volume_t rch) {
+  using namespace muses72323;
+
+  const level_plan_t *plan_l = &s_level_plan[clamp_level(lch, 0) - s_level_min];
+  const level_plan_t *plan_r = &s_level_plan[clamp_level(rch, 0) - s_level_min];
+  writeAttenuation(pgm_read_word(&plan_l->attenuation_l),
+                   pgm_read_word(&plan_r->attenuation_r));
+}
+
+template <class Transport>
+void Muses72323<Transport>::setLevel(volume_t lch, volume_t rch) {
+  using namespace muses72323;
+
+  volume_t top = clamp_level(lch > rch ? lch : rch, s_level_max);
+  const level_plan_t *plan = &s_level_plan[top - s_level_min];
+  data_t gain_bits = (data_t)pgm_read_byte(&plan->gain) << 8;
+
+  // gain code << 9 >> 8 is the gain in 0.25 dB steps. the quieter channel
+  // takes its attenuation from the (non-positive) level below the gain.
+  volume_t quarters = gain_bits >> 8;
+  const level_plan_t *plan_l = lch == top ? plan :
+    &s_level_plan[clamp_level(lch - quarters, 0) - s_level_min];
+  const level_plan_t *plan_r = rch == top ? plan :
+    &s_level_plan[clamp_level(rch - quarters, 0) - s_level_min];
+  data_t att_l = pgm_read_word(&plan_l->attenuation_l);
+  data_t att_r = pgm_read_word(&plan_r->attenuation_r);
+
+  // order the writes so a change of gain never overshoots: attenuate first
+  // when the gain goes up, drop the gain first when it goes down
+  // (the link bit shares the gain register and may change in between)
+  if (gain_bits > (gain & s_gain_mask)) {
+    writeAttenuation(att_l, att_r);
+    gain = (gain & ~s_gain_mask) | gain_bits;
+    write(reg_gain, gain);
+  } else {
+    gain = (gain & ~s_gain_mask) | gain_bits;
+    write(reg_gain, gain);
+    writeAttenuation(att_l, att_r);
+  }
+}
+
+template <class Transport>
+void Muses72323<Transport>::setGain() {
+  write(reg_gain, gain);
+}
+
+template <class Transport>
+void Muses72323<Transport>::mute() {
+  writeAttenuation(0, 0);
+}
+
+template <class Transport>
+void Muses72323<Transport>::setExternalClock(bool enabled) {
+  // 0 external, 1 internal
+  muses72323::write_bit(states, muses72323::s_state_external_clock, !enabled);
+  write(reg_states, states);
+}
+
+template <class Transport>
+void Muses72323<Transport>::setZeroCrossingOn(bool enabled) {
+  // 0 is enabled, 1 is disabled
+  muses72323::write_bit(gain, muses72323::s_state_bit_zero_crossing, !enabled);
+  write(reg_gain, gain);
+}
+
+template <class Transport>
+void Muses72323<Transport>::setLinkChannels(bool enabled) {
+  // 1 is enabled (linked channels), 0 is disabled
+  muses72323::write_bit(gain, muses72323::s_state_bit_gain, enabled);
+  write(reg_gain, gain);
+}
+
+template <class Transport>
+void Muses72323<Transport>::setSoftStep(bool enabled, uint8_t divider) {
+  // the urgent mute keeps soft step off, unmute() applies the setting
+  if (held) {
+    resume_soft_step = enabled;
+    enabled = false;
+  }
+  states &= ~(0b111 << muses72323::s_state_soft_step_divider);
+  states |= (divider & 0b111) << muses72323::s_state_soft_step_divider;
+  muses72323::write_bit(states, muses72323::s_state_soft_step, enabled);
+  write(reg_states, states);
+}
+
+template <class Transport>
+uint16_t Muses72323<Transport>::getSoftStepPeriod() const {
+  if (!(states & (1 << muses72323::s_state_soft_step))) {
+    return 0;
+  }
+  uint8_t divider = (states >> muses72323::s_state_soft_step_divider) & 0b111;
+  return muses72323::s_soft_step_base_us << divider;
+}
+
+template <class Transport>
+uint32_t Muses72323<Transport>::getSettleTime() const {
+  int32_t remaining = (int32_t)(ramp_end - Transport::now());
+  return remaining > 0 ? remaining : 0;
+}
+
+template <class Transport>
+void Muses72323<Transport>::urgentMute() {
+  // whatever is staged was planned before the mute, commit() drops it
+  cancel_staged = true;
+  bool interrupted = in_frame;
+  if (interrupted && !Transport::isAsync()) {
+    mute_pending = true;
+    return;
+  }
+  applyUrgentMute();
+  if (interrupted) {
+    // the frame being pushed was planned before the mute
+    mute_pending = true;
+  }
+}
+
+template <class Transport>
+void Muses72323<Transport>::unmute() {
+  // an urgentMute() from here on must not be released by this call
+  muses72323::interrupt_guard guard;
+  if (!held) {
+    return;
+  }
+  held = false;
+  muses72323::write_bit(states, muses72323::s_state_soft_step, resume_soft_step);
+  write(reg_states, states);
+  // a setter cut short by the mute may have changed the link bit without
+  // sending it
+  write(reg_gain, gain);
+}
+
+template <class Transport>
+void Muses72323<Transport>::applyUrgentMute() {
+  bool was_staging = staging;
+  staging = false;
+  Transport::discard();
+  if (!held) {
+    resume_soft_step = states & (1 << muses72323::s_state_soft_step);
+  }
+  held = false;
+  shadow_valid = 0;
+  muses72323::write_bit(states, muses72323::s_state_soft_step, false);
+  write(reg_states, states);
+  // both registers, whatever gain says about the link: a link word dropped
+  // by discard() never reached the chip. gain is resent afterwards so the
+  // link state matches it again.
+  write(reg_attenuation_l, 0);
+  write(reg_attenuation_r, 0);
+  write(reg_gain, gain);
+  held = true;
+  staging = was_staging;
+}
+
+template <class Transport>
+void Muses72323<Transport>::beginCommit() {
+  cancel_staged = false;
+  staging = true;
+  unmute();
+}
+
+template <class Transport>
+void Muses72323<Transport>::commit() {
+  // still staging while the frames go out, so an urgentMute() between two
+  // of them cancels the rest
+  Transport::beginBurst();
+  for (uint8_t i = 0; i < staged_count && !cancel_staged; i++) {
+    sendFrame(staged[i]);
+  }
+  Transport::endBurst();
+  staged_count = 0;
+  staging = false;
+
+  if (mute_pending) {
+    mute_pending = false;
+    applyUrgentMute();
+  }
+}
+
+template <class Transport>
+bool Muses72323<Transport>::scrub() {
+  if (!scrub_interval || !shadow_valid || !Transport::idle()) {
+    return false;
+  }
+  uint32_t now = Transport::now();
+  if (now - scrub_last < (uint32_t)scrub_interval * 1000) {
+    return false;
+  }
+
+  while (!(shadow_valid & (1 << scrub_next))) {
+    scrub_next = (scrub_next + 1) % reg_count;
+  }
+
+  {
+    // an interrupt writing this register between reading the shadow and
+    // sending it would otherwise be overwritten with the older value
+    muses72323::interrupt_guard guard;
+    transfer(control_address((register_t)scrub_next), shadow[scrub_next]);
+  }
+  scrub_next = (scrub_next + 1) % reg_count;
+  scrub_last = now;
+  scrub_writes++;
+  return true;
+}
+
+template <class Transport>
+void Muses72323<Transport>::resetTransferCounters() {
+  transfers_issued = 0;
+  transfers_elided = 0;
+}
+
+template <class Transport>
+void Muses72323<Transport>::writeAttenuation(data_t left, data_t right) {
+  using namespace muses72323;
+
+  if (!auto_link) {
+    write(reg_attenuation_l, left);
+    write(reg_attenuation_r, right);
+    return;
+  }
+
+  bool linked = gain & (1 << s_state_bit_gain);
+
+  if (left == right) {
+    // left first, then link: right moves straight to the new level
+    write(reg_attenuation_l, left);
+    if (!linked) {
+      setLinkChannels(true);
+    }
+    return;
+  }
+
+  if (linked) {
+    // the right register still holds whatever it had before linking. load
+    // it while it is ignored, then unlink, so right never jumps to a stale
+    // level
+    write(reg_attenuation_r, right);
+    setLinkChannels(false);
+    write(reg_attenuation_l, left);
+    return;
+  }
+
+  write(reg_attenuation_l, left);
+  write(reg_attenuation_r, right);
+}
+
+template <class Transport>
+void Muses72323<Transport>::write(register_t reg, data_t data) {
+  // an urgent mute holds against everything planned before or after it
+  if (held && reg != reg_states) {
+    return;
+  }
+  // the chip is write-only, so the shadow copy is the only record of what
+  // it holds. skip the transfer when the register already has this value.
+  if ((shadow_valid & (1 << reg)) && shadow[reg] == data) {
+    transfers_elided++;
+    return;
+  }
+  uint16_t period = getSoftStepPeriod();
+  if (period && reg <= reg_attenuation_r) {
+    // both channels ramp in parallel, the output settles with the later one
+    uint16_t from = (shadow_valid & (1 << reg)) ? shadow[reg] : 0;
+    uint32_t end = Transport::now() +
+                   (uint32_t)muses72323::attenuation_steps(from, data) * period;
+    if (settled() || (int32_t)(end - ramp_end) > 0) {
+      ramp_end = end;
+    }
+  }
+
+  shadow[reg] = data;
+  shadow_valid |= 1 << reg;
+  transfers_issued++;
+  transfer(control_address(reg), data);
+}
+
+template <class Transport>
+void Muses72323<Transport>::transfer(address_t address, data_t data) {
+  data_t frame = address | chip_address | data;
+  if (staging) {
+    if (staged_count == commit_size) {
+      commit();
+      staging = true;
+    }
+    staged[staged_count++] = frame;
+    return;
+  }
+  sendFrame(frame);
+  if (mute_pending) {
+    mute_pending = false;
+    applyUrgentMute();
+  }
+}
+
+template <class Transport>
+void Muses72323<Transport>::sendFrame(data_t frame) {
+  using namespace muses72323;
+
+  // urgentMute() checks in_frame to avoid interleaving with this frame
+  in_frame = true;
+  // a mute that landed after write() let this frame through still holds
+  if (!held || (frame & s_select_mask) == (s_control_states & s_select_mask)) {
+#ifdef MUSES72323_TRACE
+    // recorded as sent, staged frames a mute cancels never show up
+    address_t address = frame & s_select_mask;
+    if (address == (s_control_states & s_select_mask)) {
+      address = s_control_states;
+    }
+    muses72323_trace_record(address | chip_address,
+                            frame & ~(s_select_mask | 0b11));
+#endif
+    Transport::send(frame);
+  }
+  in_frame = false;
+}
+
 #endif // INCLUDED_MUSES_72323
@@ -0,0 +1,101 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2016 Christoffer Hjalmarsson
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy of
+  this software and associated documentation files (the "Software"), to deal in
+  the Software without restriction, including without limitation the rights to
+  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+  the Software, and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+  FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef INCLUDED_MUSES_72323_GROUP
+#define INCLUDED_MUSES_72323_GROUP
+
+#include "Muses72323.h"
+
+// Up to four MUSES72323s on one bus and one latch (chip select), told apart
+// by the address wired into their ADR pins. A logical level or mute change
+// is applied to every chip as one back to back burst, with an optional
+// per-chip offset, e.g. for a multichannel or bi-amped setup.
+template <class Transport, uint8_t Size = 4>
+class Muses72323Group {
+  public:
+    typedef Muses72323<Transport> chip_t;
+    typedef typename chip_t::volume_t volume_t;
+
+    Muses72323Group(): count(0), last_words(0) {}
+
+    // add a chip, offset (0.25 dB steps) is added to every level it is
+    // given. returns false when the group is full.
+    bool add(chip_t &chip, volume_t offset = 0) {
+      if (count == Size) {
+        return false;
+      }
+      chips[count] = &chip;
+      offsets[count] = offset;
+      count++;
+      return true;
+    }
+
+    void setOffset(uint8_t index, volume_t offset) { offsets[index] = offset; }
+
+    // set up the shared transport
+    void begin() { Transport::begin(); }
+
+    // set every chip to level + its offset, see Muses72323::setLevel()
+    void setLevel(volume_t left, volume_t right) {
+      uint32_t before = issued();
+      Transport::beginBurst();
+      for (uint8_t i = 0; i < count; i++) {
+        chips[i]->setLevel(left + offsets[i], right + offsets[i]);
+      }
+      Transport::endBurst();
+      last_words = issued() - before;
+    }
+
+    void mute() {
+      uint32_t before = issued();
+      Transport::beginBurst();
+      for (uint8_t i = 0; i < count; i++) {
+        chips[i]->mute();
+      }
+      Transport::endBurst();
+      last_words = issued() - before;
+    }
+
+    // words sent by the last update, writes the shadow registers already
+    // held are not counted
+    uint8_t getLastWords() const { return last_words; }
+
+    // nominal bus time of the last update in microseconds
+    uint16_t getLastBusTime() const { return (uint16_t)last_words * Transport::frame_us; }
+
+  private:
+    uint32_t issued() const {
+      uint32_t total = 0;
+      for (uint8_t i = 0; i < count; i++) {
+        total += chips[i]->getIssuedTransfers();
+      }
+      return total;
+    }
+
+    chip_t *chips[Size];
+    volume_t offsets[Size];
+    uint8_t count;
+    uint8_t last_words;
+};
+
+#endif // INCLUDED_MUSES_72323_GROUP
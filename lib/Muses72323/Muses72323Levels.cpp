@@ -0,0 +1,587 @@
+// generated by tools/gen_muses_tables.py, do not edit
+
+#include "Muses72323Levels.h"
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#endif
+
+namespace muses72323 {
+const level_plan_t s_level_plan[] PROGMEM = {
+  { 0xEF80, 0xEF80, 0x00 }, // -111.75 dB
+  { 0xEF00, 0xEF00, 0x00 }, // -111.50 dB
+  { 0xEE80, 0xEE80, 0x00 }, // -111.25 dB
+  { 0xEE00, 0xEE00, 0x00 }, // -111.00 dB
+  { 0xED80, 0xED80, 0x00 }, // -110.75 dB
+  { 0xED00, 0xED00, 0x00 }, // -110.50 dB
+  { 0xEC80, 0xEC80, 0x00 }, // -110.25 dB
+  { 0xEC00, 0xEC00, 0x00 }, // -110.00 dB
+  { 0xEB80, 0xEB80, 0x00 }, // -109.75 dB
+  { 0xEB00, 0xEB00, 0x00 }, // -109.50 dB
+  { 0xEA80, 0xEA80, 0x00 }, // -109.25 dB
+  { 0xEA00, 0xEA00, 0x00 }, // -109.00 dB
+  { 0xE980, 0xE980, 0x00 }, // -108.75 dB
+  { 0xE900, 0xE900, 0x00 }, // -108.50 dB
+  { 0xE880, 0xE880, 0x00 }, // -108.25 dB
+  { 0xE800, 0xE800, 0x00 }, // -108.00 dB
+  { 0xE780, 0xE780, 0x00 }, // -107.75 dB
+  { 0xE700, 0xE700, 0x00 }, // -107.50 dB
+  { 0xE680, 0xE680, 0x00 }, // -107.25 dB
+  { 0xE600, 0xE600, 0x00 }, // -107.00 dB
+  { 0xE580, 0xE580, 0x00 }, // -106.75 dB
+  { 0xE500, 0xE500, 0x00 }, // -106.50 dB
+  { 0xE480, 0xE480, 0x00 }, // -106.25 dB
+  { 0xE400, 0xE400, 0x00 }, // -106.00 dB
+  { 0xE380, 0xE380, 0x00 }, // -105.75 dB
+  { 0xE300, 0xE300, 0x00 }, // -105.50 dB
+  { 0xE280, 0xE280, 0x00 }, // -105.25 dB
+  { 0xE200, 0xE200, 0x00 }, // -105.00 dB
+  { 0xE180, 0xE180, 0x00 }, // -104.75 dB
+  { 0xE100, 0xE100, 0x00 }, // -104.50 dB
+  { 0xE080, 0xE080, 0x00 }, // -104.25 dB
+  { 0xE000, 0xE000, 0x00 }, // -104.00 dB
+  { 0xDF80, 0xDF80, 0x00 }, // -103.75 dB
+  { 0xDF00, 0xDF00, 0x00 }, // -103.50 dB
+  { 0xDE80, 0xDE80, 0x00 }, // -103.25 dB
+  { 0xDE00, 0xDE00, 0x00 }, // -103.00 dB
+  { 0xDD80, 0xDD80, 0x00 }, // -102.75 dB
+  { 0xDD00, 0xDD00, 0x00 }, // -102.50 dB
+  { 0xDC80, 0xDC80, 0x00 }, // -102.25 dB
+  { 0xDC00, 0xDC00, 0x00 }, // -102.00 dB
+  { 0xDB80, 0xDB80, 0x00 }, // -101.75 dB
+  { 0xDB00, 0xDB00, 0x00 }, // -101.50 dB
+  { 0xDA80, 0xDA80, 0x00 }, // -101.25 dB
+  { 0xDA00, 0xDA00, 0x00 }, // -101.00 dB
+  { 0xD980, 0xD980, 0x00 }, // -100.75 dB
+  { 0xD900, 0xD900, 0x00 }, // -100.50 dB
+  { 0xD880, 0xD880, 0x00 }, // -100.25 dB
+  { 0xD800, 0xD800, 0x00 }, // -100.00 dB
+  { 0xD780, 0xD780, 0x00 }, //  -99.75 dB
+  { 0xD700, 0xD700, 0x00 }, //  -99.50 dB
+  { 0xD680, 0xD680, 0x00 }, //  -99.25 dB
+  { 0xD600, 0xD600, 0x00 }, //  -99.00 dB
+  { 0xD580, 0xD580, 0x00 }, //  -98.75 dB
+  { 0xD500, 0xD500, 0x00 }, //  -98.50 dB
+  { 0xD480, 0xD480, 0x00 }, //  -98.25 dB
+  { 0xD400, 0xD400, 0x00 }, //  -98.00 dB
+  { 0xD380, 0xD380, 0x00 }, //  -97.75 dB
+  { 0xD300, 0xD300, 0x00 }, //  -97.50 dB
+  { 0xD280, 0xD280, 0x00 }, //  -97.25 dB
+  { 0xD200, 0xD200, 0x00 }, //  -97.00 dB
+  { 0xD180, 0xD180, 0x00 }, //  -96.75 dB
+  { 0xD100, 0xD100, 0x00 }, //  -96.50 dB
+  { 0xD080, 0xD080, 0x00 }, //  -96.25 dB
+  { 0xD000, 0xD000, 0x00 }, //  -96.00 dB
+  { 0xCF80, 0xCF80, 0x00 }, //  -95.75 dB
+  { 0xCF00, 0xCF00, 0x00 }, //  -95.50 dB
+  { 0xCE80, 0xCE80, 0x00 }, //  -95.25 dB
+  { 0xCE00, 0xCE00, 0x00 }, //  -95.00 dB
+  { 0xCD80, 0xCD80, 0x00 }, //  -94.75 dB
+  { 0xCD00, 0xCD00, 0x00 }, //  -94.50 dB
+  { 0xCC80, 0xCC80, 0x00 }, //  -94.25 dB
+  { 0xCC00, 0xCC00, 0x00 }, //  -94.00 dB
+  { 0xCB80, 0xCB80, 0x00 }, //  -93.75 dB
+  { 0xCB00, 0xCB00, 0x00 }, //  -93.50 dB
+  { 0xCA80, 0xCA80, 0x00 }, //  -93.25 dB
+  { 0xCA00, 0xCA00, 0x00 }, //  -93.00 dB
+  { 0xC980, 0xC980, 0x00 }, //  -92.75 dB
+  { 0xC900, 0xC900, 0x00 }, //  -92.50 dB
+  { 0xC880, 0xC880, 0x00 }, //  -92.25 dB
+  { 0xC800, 0xC800, 0x00 }, //  -92.00 dB
+  { 0xC780, 0xC780, 0x00 }, //  -91.75 dB
+  { 0xC700, 0xC700, 0x00 }, //  -91.50 dB
+  { 0xC680, 0xC680, 0x00 }, //  -91.25 dB
+  { 0xC600, 0xC600, 0x00 }, //  -91.00 dB
+  { 0xC580, 0xC580, 0x00 }, //  -90.75 dB
+  { 0xC500, 0xC500, 0x00 }, //  -90.50 dB
+  { 0xC480, 0xC480, 0x00 }, //  -90.25 dB
+  { 0xC400, 0xC400, 0x00 }, //  -90.00 dB
+  { 0xC380, 0xC380, 0x00 }, //  -89.75 dB
+  { 0xC300, 0xC300, 0x00 }, //  -89.50 dB
+  { 0xC280, 0xC280, 0x00 }, //  -89.25 dB
+  { 0xC200, 0xC200, 0x00 }, //  -89.00 dB
+  { 0xC180, 0xC180, 0x00 }, //  -88.75 dB
+  { 0xC100, 0xC100, 0x00 }, //  -88.50 dB
+  { 0xC080, 0xC080, 0x00 }, //  -88.25 dB
+  { 0xC000, 0xC000, 0x00 }, //  -88.00 dB
+  { 0xBF80, 0xBF80, 0x00 }, //  -87.75 dB
+  { 0xBF00, 0xBF00, 0x00 }, //  -87.50 dB
+  { 0xBE80, 0xBE80, 0x00 }, //  -87.25 dB
+  { 0xBE00, 0xBE00, 0x00 }, //  -87.00 dB
+  { 0xBD80, 0xBD80, 0x00 }, //  -86.75 dB
+  { 0xBD00, 0xBD00, 0x00 }, //  -86.50 dB
+  { 0xBC80, 0xBC80, 0x00 }, //  -86.25 dB
+  { 0xBC00, 0xBC00, 0x00 }, //  -86.00 dB
+  { 0xBB80, 0xBB80, 0x00 }, //  -85.75 dB
+  { 0xBB00, 0xBB00, 0x00 }, //  -85.50 dB
+  { 0xBA80, 0xBA80, 0x00 }, //  -85.25 dB
+  { 0xBA00, 0xBA00, 0x00 }, //  -85.00 dB
+  { 0xB980, 0xB980, 0x00 }, //  -84.75 dB
+  { 0xB900, 0xB900, 0x00 }, //  -84.50 dB
+  { 0xB880, 0xB880, 0x00 }, //  -84.25 dB
+  { 0xB800, 0xB800, 0x00 }, //  -84.00 dB
+  { 0xB780, 0xB780, 0x00 }, //  -83.75 dB
+  { 0xB700, 0xB700, 0x00 }, //  -83.50 dB
+  { 0xB680, 0xB680, 0x00 }, //  -83.25 dB
+  { 0xB600, 0xB600, 0x00 }, //  -83.00 dB
+  { 0xB580, 0xB580, 0x00 }, //  -82.75 dB
+  { 0xB500, 0xB500, 0x00 }, //  -82.50 dB
+  { 0xB480, 0xB480, 0x00 }, //  -82.25 dB
+  { 0xB400, 0xB400, 0x00 }, //  -82.00 dB
+  { 0xB380, 0xB380, 0x00 }, //  -81.75 dB
+  { 0xB300, 0xB300, 0x00 }, //  -81.50 dB
+  { 0xB280, 0xB280, 0x00 }, //  -81.25 dB
+  { 0xB200, 0xB200, 0x00 }, //  -81.00 dB
+  { 0xB180, 0xB180, 0x00 }, //  -80.75 dB
+  { 0xB100, 0xB100, 0x00 }, //  -80.50 dB
+  { 0xB080, 0xB080, 0x00 }, //  -80.25 dB
+  { 0xB000, 0xB000, 0x00 }, //  -80.00 dB
+  { 0xAF80, 0xAF80, 0x00 }, //  -79.75 dB
+  { 0xAF00, 0xAF00, 0x00 }, //  -79.50 dB
+  { 0xAE80, 0xAE80, 0x00 }, //  -79.25 dB
+  { 0xAE00, 0xAE00, 0x00 }, //  -79.00 dB
+  { 0xAD80, 0xAD80, 0x00 }, //  -78.75 dB
+  { 0xAD00, 0xAD00, 0x00 }, //  -78.50 dB
+  { 0xAC80, 0xAC80, 0x00 }, //  -78.25 dB
+  { 0xAC00, 0xAC00, 0x00 }, //  -78.00 dB
+  { 0xAB80, 0xAB80, 0x00 }, //  -77.75 dB
+  { 0xAB00, 0xAB00, 0x00 }, //  -77.50 dB
+  { 0xAA80, 0xAA80, 0x00 }, //  -77.25 dB
+  { 0xAA00, 0xAA00, 0x00 }, //  -77.00 dB
+  { 0xA980, 0xA980, 0x00 }, //  -76.75 dB
+  { 0xA900, 0xA900, 0x00 }, //  -76.50 dB
+  { 0xA880, 0xA880, 0x00 }, //  -76.25 dB
+  { 0xA800, 0xA800, 0x00 }, //  -76.00 dB
+  { 0xA780, 0xA780, 0x00 }, //  -75.75 dB
+  { 0xA700, 0xA700, 0x00 }, //  -75.50 dB
+  { 0xA680, 0xA680, 0x00 }, //  -75.25 dB
+  { 0xA600, 0xA600, 0x00 }, //  -75.00 dB
+  { 0xA580, 0xA580, 0x00 }, //  -74.75 dB
+  { 0xA500, 0xA500, 0x00 }, //  -74.50 dB
+  { 0xA480, 0xA480, 0x00 }, //  -74.25 dB
+  { 0xA400, 0xA400, 0x00 }, //  -74.00 dB
+  { 0xA380, 0xA380, 0x00 }, //  -73.75 dB
+  { 0xA300, 0xA300, 0x00 }, //  -73.50 dB
+  { 0xA280, 0xA280, 0x00 }, //  -73.25 dB
+  { 0xA200, 0xA200, 0x00 }, //  -73.00 dB
+  { 0xA180, 0xA180, 0x00 }, //  -72.75 dB
+  { 0xA100, 0xA100, 0x00 }, //  -72.50 dB
+  { 0xA080, 0xA080, 0x00 }, //  -72.25 dB
+  { 0xA000, 0xA000, 0x00 }, //  -72.00 dB
+  { 0x9F80, 0x9F80, 0x00 }, //  -71.75 dB
+  { 0x9F00, 0x9F00, 0x00 }, //  -71.50 dB
+  { 0x9E80, 0x9E80, 0x00 }, //  -71.25 dB
+  { 0x9E00, 0x9E00, 0x00 }, //  -71.00 dB
+  { 0x9D80, 0x9D80, 0x00 }, //  -70.75 dB
+  { 0x9D00, 0x9D00, 0x00 }, //  -70.50 dB
+  { 0x9C80, 0x9C80, 0x00 }, //  -70.25 dB
+  { 0x9C00, 0x9C00, 0x00 }, //  -70.00 dB
+  { 0x9B80, 0x9B80, 0x00 }, //  -69.75 dB
+  { 0x9B00, 0x9B00, 0x00 }, //  -69.50 dB
+  { 0x9A80, 0x9A80, 0x00 }, //  -69.25 dB
+  { 0x9A00, 0x9A00, 0x00 }, //  -69.00 dB
+  { 0x9980, 0x9980, 0x00 }, //  -68.75 dB
+  { 0x9900, 0x9900, 0x00 }, //  -68.50 dB
+  { 0x9880, 0x9880, 0x00 }, //  -68.25 dB
+  { 0x9800, 0x9800, 0x00 }, //  -68.00 dB
+  { 0x9780, 0x9780, 0x00 }, //  -67.75 dB
+  { 0x9700, 0x9700, 0x00 }, //  -67.50 dB
+  { 0x9680, 0x9680, 0x00 }, //  -67.25 dB
+  { 0x9600, 0x9600, 0x00 }, //  -67.00 dB
+  { 0x9580, 0x9580, 0x00 }, //  -66.75 dB
+  { 0x9500, 0x9500, 0x00 }, //  -66.50 dB
+  { 0x9480, 0x9480, 0x00 }, //  -66.25 dB
+  { 0x9400, 0x9400, 0x00 }, //  -66.00 dB
+  { 0x9380, 0x9380, 0x00 }, //  -65.75 dB
+  { 0x9300, 0x9300, 0x00 }, //  -65.50 dB
+  { 0x9280, 0x9280, 0x00 }, //  -65.25 dB
+  { 0x9200, 0x9200, 0x00 }, //  -65.00 dB
+  { 0x9180, 0x9180, 0x00 }, //  -64.75 dB
+  { 0x9100, 0x9100, 0x00 }, //  -64.50 dB
+  { 0x9080, 0x9080, 0x00 }, //  -64.25 dB
+  { 0x9000, 0x9000, 0x00 }, //  -64.00 dB
+  { 0x8F80, 0x8F80, 0x00 }, //  -63.75 dB
+  { 0x8F00, 0x8F00, 0x00 }, //  -63.50 dB
+  { 0x8E80, 0x8E80, 0x00 }, //  -63.25 dB
+  { 0x8E00, 0x8E00, 0x00 }, //  -63.00 dB
+  { 0x8D80, 0x8D80, 0x00 }, //  -62.75 dB
+  { 0x8D00, 0x8D00, 0x00 }, //  -62.50 dB
+  { 0x8C80, 0x8C80, 0x00 }, //  -62.25 dB
+  { 0x8C00, 0x8C00, 0x00 }, //  -62.00 dB
+  { 0x8B80, 0x8B80, 0x00 }, //  -61.75 dB
+  { 0x8B00, 0x8B00, 0x00 }, //  -61.50 dB
+  { 0x8A80, 0x8A80, 0x00 }, //  -61.25 dB
+  { 0x8A00, 0x8A00, 0x00 }, //  -61.00 dB
+  { 0x8980, 0x8980, 0x00 }, //  -60.75 dB
+  { 0x8900, 0x8900, 0x00 }, //  -60.50 dB
+  { 0x8880, 0x8880, 0x00 }, //  -60.25 dB
+  { 0x8800, 0x8800, 0x00 }, //  -60.00 dB
+  { 0x8780, 0x8780, 0x00 }, //  -59.75 dB
+  { 0x8700, 0x8700, 0x00 }, //  -59.50 dB
+  { 0x8680, 0x8680, 0x00 }, //  -59.25 dB
+  { 0x8600, 0x8600, 0x00 }, //  -59.00 dB
+  { 0x8580, 0x8580, 0x00 }, //  -58.75 dB
+  { 0x8500, 0x8500, 0x00 }, //  -58.50 dB
+  { 0x8480, 0x8480, 0x00 }, //  -58.25 dB
+  { 0x8400, 0x8400, 0x00 }, //  -58.00 dB
+  { 0x8380, 0x8380, 0x00 }, //  -57.75 dB
+  { 0x8300, 0x8300, 0x00 }, //  -57.50 dB
+  { 0x8280, 0x8280, 0x00 }, //  -57.25 dB
+  { 0x8200, 0x8200, 0x00 }, //  -57.00 dB
+  { 0x8180, 0x8180, 0x00 }, //  -56.75 dB
+  { 0x8100, 0x8100, 0x00 }, //  -56.50 dB
+  { 0x8080, 0x8080, 0x00 }, //  -56.25 dB
+  { 0x8000, 0x8000, 0x00 }, //  -56.00 dB
+  { 0x7F80, 0x7F80, 0x00 }, //  -55.75 dB
+  { 0x7F00, 0x7F00, 0x00 }, //  -55.50 dB
+  { 0x7E80, 0x7E80, 0x00 }, //  -55.25 dB
+  { 0x7E00, 0x7E00, 0x00 }, //  -55.00 dB
+  { 0x7D80, 0x7D80, 0x00 }, //  -54.75 dB
+  { 0x7D00, 0x7D00, 0x00 }, //  -54.50 dB
+  { 0x7C80, 0x7C80, 0x00 }, //  -54.25 dB
+  { 0x7C00, 0x7C00, 0x00 }, //  -54.00 dB
+  { 0x7B80, 0x7B80, 0x00 }, //  -53.75 dB
+  { 0x7B00, 0x7B00, 0x00 }, //  -53.50 dB
+  { 0x7A80, 0x7A80, 0x00 }, //  -53.25 dB
+  { 0x7A00, 0x7A00, 0x00 }, //  -53.00 dB
+  { 0x7980, 0x7980, 0x00 }, //  -52.75 dB
+  { 0x7900, 0x7900, 0x00 }, //  -52.50 dB
+  { 0x7880, 0x7880, 0x00 }, //  -52.25 dB
+  { 0x7800, 0x7800, 0x00 }, //  -52.00 dB
+  { 0x7780, 0x7780, 0x00 }, //  -51.75 dB
+  { 0x7700, 0x7700, 0x00 }, //  -51.50 dB
+  { 0x7680, 0x7680, 0x00 }, //  -51.25 dB
+  { 0x7600, 0x7600, 0x00 }, //  -51.00 dB
+  { 0x7580, 0x7580, 0x00 }, //  -50.75 dB
+  { 0x7500, 0x7500, 0x00 }, //  -50.50 dB
+  { 0x7480, 0x7480, 0x00 }, //  -50.25 dB
+  { 0x7400, 0x7400, 0x00 }, //  -50.00 dB
+  { 0x7380, 0x7380, 0x00 }, //  -49.75 dB
+  { 0x7300, 0x7300, 0x00 }, //  -49.50 dB
+  { 0x7280, 0x7280, 0x00 }, //  -49.25 dB
+  { 0x7200, 0x7200, 0x00 }, //  -49.00 dB
+  { 0x7180, 0x7180, 0x00 }, //  -48.75 dB
+  { 0x7100, 0x7100, 0x00 }, //  -48.50 dB
+  { 0x7080, 0x7080, 0x00 }, //  -48.25 dB
+  { 0x7000, 0x7000, 0x00 }, //  -48.00 dB
+  { 0x6F80, 0x6F80, 0x00 }, //  -47.75 dB
+  { 0x6F00, 0x6F00, 0x00 }, //  -47.50 dB
+  { 0x6E80, 0x6E80, 0x00 }, //  -47.25 dB
+  { 0x6E00, 0x6E00, 0x00 }, //  -47.00 dB
+  { 0x6D80, 0x6D80, 0x00 }, //  -46.75 dB
+  { 0x6D00, 0x6D00, 0x00 }, //  -46.50 dB
+  { 0x6C80, 0x6C80, 0x00 }, //  -46.25 dB
+  { 0x6C00, 0x6C00, 0x00 }, //  -46.00 dB
+  { 0x6B80, 0x6B80, 0x00 }, //  -45.75 dB
+  { 0x6B00, 0x6B00, 0x00 }, //  -45.50 dB
+  { 0x6A80, 0x6A80, 0x00 }, //  -45.25 dB
+  { 0x6A00, 0x6A00, 0x00 }, //  -45.00 dB
+  { 0x6980, 0x6980, 0x00 }, //  -44.75 dB
+  { 0x6900, 0x6900, 0x00 }, //  -44.50 dB
+  { 0x6880, 0x6880, 0x00 }, //  -44.25 dB
+  { 0x6800, 0x6800, 0x00 }, //  -44.00 dB
+  { 0x6780, 0x6780, 0x00 }, //  -43.75 dB
+  { 0x6700, 0x6700, 0x00 }, //  -43.50 dB
+  { 0x6680, 0x6680, 0x00 }, //  -43.25 dB
+  { 0x6600, 0x6600, 0x00 }, //  -43.00 dB
+  { 0x6580, 0x6580, 0x00 }, //  -42.75 dB
+  { 0x6500, 0x6500, 0x00 }, //  -42.50 dB
+  { 0x6480, 0x6480, 0x00 }, //  -42.25 dB
+  { 0x6400, 0x6400, 0x00 }, //  -42.00 dB
+  { 0x6380, 0x6380, 0x00 }, //  -41.75 dB
+  { 0x6300, 0x6300, 0x00 }, //  -41.50 dB
+  { 0x6280, 0x6280, 0x00 }, //  -41.25 dB
+  { 0x6200, 0x6200, 0x00 }, //  -41.00 dB
+  { 0x6180, 0x6180, 0x00 }, //  -40.75 dB
+  { 0x6100, 0x6100, 0x00 }, //  -40.50 dB
+  { 0x6080, 0x6080, 0x00 }, //  -40.25 dB
+  { 0x6000, 0x6000, 0x00 }, //  -40.00 dB
+  { 0x5F80, 0x5F80, 0x00 }, //  -39.75 dB
+  { 0x5F00, 0x5F00, 0x00 }, //  -39.50 dB
+  { 0x5E80, 0x5E80, 0x00 }, //  -39.25 dB
+  { 0x5E00, 0x5E00, 0x00 }, //  -39.00 dB
+  { 0x5D80, 0x5D80, 0x00 }, //  -38.75 dB
+  { 0x5D00, 0x5D00, 0x00 }, //  -38.50 dB
+  { 0x5C80, 0x5C80, 0x00 }, //  -38.25 dB
+  { 0x5C00, 0x5C00, 0x00 }, //  -38.00 dB
+  { 0x5B80, 0x5B80, 0x00 }, //  -37.75 dB
+  { 0x5B00, 0x5B00, 0x00 }, //  -37.50 dB
+  { 0x5A80, 0x5A80, 0x00 }, //  -37.25 dB
+  { 0x5A00, 0x5A00, 0x00 }, //  -37.00 dB
+  { 0x5980, 0x5980, 0x00 }, //  -36.75 dB
+  { 0x5900, 0x5900, 0x00 }, //  -36.50 dB
+  { 0x5880, 0x5880, 0x00 }, //  -36.25 dB
+  { 0x5800, 0x5800, 0x00 }, //  -36.00 dB
+  { 0x5780, 0x5780, 0x00 }, //  -35.75 dB
+  { 0x5700, 0x5700, 0x00 }, //  -35.50 dB
+  { 0x5680, 0x5680, 0x00 }, //  -35.25 dB
+  { 0x5600, 0x5600, 0x00 }, //  -35.00 dB
+  { 0x5580, 0x5580, 0x00 }, //  -34.75 dB
+  { 0x5500, 0x5500, 0x00 }, //  -34.50 dB
+  { 0x5480, 0x5480, 0x00 }, //  -34.25 dB
+  { 0x5400, 0x5400, 0x00 }, //  -34.00 dB
+  { 0x5380, 0x5380, 0x00 }, //  -33.75 dB
+  { 0x5300, 0x5300, 0x00 }, //  -33.50 dB
+  { 0x5280, 0x5280, 0x00 }, //  -33.25 dB
+  { 0x5200, 0x5200, 0x00 }, //  -33.00 dB
+  { 0x5180, 0x5180, 0x00 }, //  -32.75 dB
+  { 0x5100, 0x5100, 0x00 }, //  -32.50 dB
+  { 0x5080, 0x5080, 0x00 }, //  -32.25 dB
+  { 0x5000, 0x5000, 0x00 }, //  -32.00 dB
+  { 0x4F80, 0x4F80, 0x00 }, //  -31.75 dB
+  { 0x4F00, 0x4F00, 0x00 }, //  -31.50 dB
+  { 0x4E80, 0x4E80, 0x00 }, //  -31.25 dB
+  { 0x4E00, 0x4E00, 0x00 }, //  -31.00 dB
+  { 0x4D80, 0x4D80, 0x00 }, //  -30.75 dB
+  { 0x4D00, 0x4D00, 0x00 }, //  -30.50 dB
+  { 0x4C80, 0x4C80, 0x00 }, //  -30.25 dB
+  { 0x4C00, 0x4C00, 0x00 }, //  -30.00 dB
+  { 0x4B80, 0x4B80, 0x00 }, //  -29.75 dB
+  { 0x4B00, 0x4B00, 0x00 }, //  -29.50 dB
+  { 0x4A80, 0x4A80, 0x00 }, //  -29.25 dB
+  { 0x4A00, 0x4A00, 0x00 }, //  -29.00 dB
+  { 0x4980, 0x4980, 0x00 }, //  -28.75 dB
+  { 0x4900, 0x4900, 0x00 }, //  -28.50 dB
+  { 0x4880, 0x4880, 0x00 }, //  -28.25 dB
+  { 0x4800, 0x4800, 0x00 }, //  -28.00 dB
+  { 0x4780, 0x4780, 0x00 }, //  -27.75 dB
+  { 0x4700, 0x4700, 0x00 }, //  -27.50 dB
+  { 0x4680, 0x4680, 0x00 }, //  -27.25 dB
+  { 0x4600, 0x4600, 0x00 }, //  -27.00 dB
+  { 0x4580, 0x4580, 0x00 }, //  -26.75 dB
+  { 0x4500, 0x4500, 0x00 }, //  -26.50 dB
+  { 0x4480, 0x4480, 0x00 }, //  -26.25 dB
+  { 0x4400, 0x4400, 0x00 }, //  -26.00 dB
+  { 0x4380, 0x4380, 0x00 }, //  -25.75 dB
+  { 0x4300, 0x4300, 0x00 }, //  -25.50 dB
+  { 0x4280, 0x4280, 0x00 }, //  -25.25 dB
+  { 0x4200, 0x4200, 0x00 }, //  -25.00 dB
+  { 0x4180, 0x4180, 0x00 }, //  -24.75 dB
+  { 0x4100, 0x4100, 0x00 }, //  -24.50 dB
+  { 0x4080, 0x4080, 0x00 }, //  -24.25 dB
+  { 0x4000, 0x4000, 0x00 }, //  -24.00 dB
+  { 0x3F80, 0x3F80, 0x00 }, //  -23.75 dB
+  { 0x3F00, 0x3F00, 0x00 }, //  -23.50 dB
+  { 0x3E80, 0x3E80, 0x00 }, //  -23.25 dB
+  { 0x3E00, 0x3E00, 0x00 }, //  -23.00 dB
+  { 0x3D80, 0x3D80, 0x00 }, //  -22.75 dB
+  { 0x3D00, 0x3D00, 0x00 }, //  -22.50 dB
+  { 0x3C80, 0x3C80, 0x00 }, //  -22.25 dB
+  { 0x3C00, 0x3C00, 0x00 }, //  -22.00 dB
+  { 0x3B80, 0x3B80, 0x00 }, //  -21.75 dB
+  { 0x3B00, 0x3B00, 0x00 }, //  -21.50 dB
+  { 0x3A80, 0x3A80, 0x00 }, //  -21.25 dB
+  { 0x3A00, 0x3A00, 0x00 }, //  -21.00 dB
+  { 0x3980, 0x3980, 0x00 }, //  -20.75 dB
+  { 0x3900, 0x3900, 0x00 }, //  -20.50 dB
+  { 0x3880, 0x3880, 0x00 }, //  -20.25 dB
+  { 0x3800, 0x3800, 0x00 }, //  -20.00 dB
+  { 0x3780, 0x3780, 0x00 }, //  -19.75 dB
+  { 0x3700, 0x3700, 0x00 }, //  -19.50 dB
+  { 0x3680, 0x3680, 0x00 }, //  -19.25 dB
+  { 0x3600, 0x3600, 0x00 }, //  -19.00 dB
+  { 0x3580, 0x3580, 0x00 }, //  -18.75 dB
+  { 0x3500, 0x3500, 0x00 }, //  -18.50 dB
+  { 0x3480, 0x3480, 0x00 }, //  -18.25 dB
+  { 0x3400, 0x3400, 0x00 }, //  -18.00 dB
+  { 0x3380, 0x3380, 0x00 }, //  -17.75 dB
+  { 0x3300, 0x3300, 0x00 }, //  -17.50 dB
+  { 0x3280, 0x3280, 0x00 }, //  -17.25 dB
+  { 0x3200, 0x3200, 0x00 }, //  -17.00 dB
+  { 0x3180, 0x3180, 0x00 }, //  -16.75 dB
+  { 0x3100, 0x3100, 0x00 }, //  -16.50 dB
+  { 0x3080, 0x3080, 0x00 }, //  -16.25 dB
+  { 0x3000, 0x3000, 0x00 }, //  -16.00 dB
+  { 0x2F80, 0x2F80, 0x00 }, //  -15.75 dB
+  { 0x2F00, 0x2F00, 0x00 }, //  -15.50 dB
+  { 0x2E80, 0x2E80, 0x00 }, //  -15.25 dB
+  { 0x2E00, 0x2E00, 0x00 }, //  -15.00 dB
+  { 0x2D80, 0x2D80, 0x00 }, //  -14.75 dB
+  { 0x2D00, 0x2D00, 0x00 }, //  -14.50 dB
+  { 0x2C80, 0x2C80, 0x00 }, //  -14.25 dB
+  { 0x2C00, 0x2C00, 0x00 }, //  -14.00 dB
+  { 0x2B80, 0x2B80, 0x00 }, //  -13.75 dB
+  { 0x2B00, 0x2B00, 0x00 }, //  -13.50 dB
+  { 0x2A80, 0x2A80, 0x00 }, //  -13.25 dB
+  { 0x2A00, 0x2A00, 0x00 }, //  -13.00 dB
+  { 0x2980, 0x2980, 0x00 }, //  -12.75 dB
+  { 0x2900, 0x2900, 0x00 }, //  -12.50 dB
+  { 0x2880, 0x2880, 0x00 }, //  -12.25 dB
+  { 0x2800, 0x2800, 0x00 }, //  -12.00 dB
+  { 0x2780, 0x2780, 0x00 }, //  -11.75 dB
+  { 0x2700, 0x2700, 0x00 }, //  -11.50 dB
+  { 0x2680, 0x2680, 0x00 }, //  -11.25 dB
+  { 0x2600, 0x2600, 0x00 }, //  -11.00 dB
+  { 0x2580, 0x2580, 0x00 }, //  -10.75 dB
+  { 0x2500, 0x2500, 0x00 }, //  -10.50 dB
+  { 0x2480, 0x2480, 0x00 }, //  -10.25 dB
+  { 0x2400, 0x2400, 0x00 }, //  -10.00 dB
+  { 0x2380, 0x2380, 0x00 }, //   -9.75 dB
+  { 0x2300, 0x2300, 0x00 }, //   -9.50 dB
+  { 0x2280, 0x2280, 0x00 }, //   -9.25 dB
+  { 0x2200, 0x2200, 0x00 }, //   -9.00 dB
+  { 0x2180, 0x2180, 0x00 }, //   -8.75 dB
+  { 0x2100, 0x2100, 0x00 }, //   -8.50 dB
+  { 0x2080, 0x2080, 0x00 }, //   -8.25 dB
+  { 0x2000, 0x2000, 0x00 }, //   -8.00 dB
+  { 0x1F80, 0x1F80, 0x00 }, //   -7.75 dB
+  { 0x1F00, 0x1F00, 0x00 }, //   -7.50 dB
+  { 0x1E80, 0x1E80, 0x00 }, //   -7.25 dB
+  { 0x1E00, 0x1E00, 0x00 }, //   -7.00 dB
+  { 0x1D80, 0x1D80, 0x00 }, //   -6.75 dB
+  { 0x1D00, 0x1D00, 0x00 }, //   -6.50 dB
+  { 0x1C80, 0x1C80, 0x00 }, //   -6.25 dB
+  { 0x1C00, 0x1C00, 0x00 }, //   -6.00 dB
+  { 0x1B80, 0x1B80, 0x00 }, //   -5.75 dB
+  { 0x1B00, 0x1B00, 0x00 }, //   -5.50 dB
+  { 0x1A80, 0x1A80, 0x00 }, //   -5.25 dB
+  { 0x1A00, 0x1A00, 0x00 }, //   -5.00 dB
+  { 0x1980, 0x1980, 0x00 }, //   -4.75 dB
+  { 0x1900, 0x1900, 0x00 }, //   -4.50 dB
+  { 0x1880, 0x1880, 0x00 }, //   -4.25 dB
+  { 0x1800, 0x1800, 0x00 }, //   -4.00 dB
+  { 0x1780, 0x1780, 0x00 }, //   -3.75 dB
+  { 0x1700, 0x1700, 0x00 }, //   -3.50 dB
+  { 0x1680, 0x1680, 0x00 }, //   -3.25 dB
+  { 0x1600, 0x1600, 0x00 }, //   -3.00 dB
+  { 0x1580, 0x1580, 0x00 }, //   -2.75 dB
+  { 0x1500, 0x1500, 0x00 }, //   -2.50 dB
+  { 0x1480, 0x1480, 0x00 }, //   -2.25 dB
+  { 0x1400, 0x1400, 0x00 }, //   -2.00 dB
+  { 0x1380, 0x1380, 0x00 }, //   -1.75 dB
+  { 0x1300, 0x1300, 0x00 }, //   -1.50 dB
+  { 0x1280, 0x1280, 0x00 }, //   -1.25 dB
+  { 0x1200, 0x1200, 0x00 }, //   -1.00 dB
+  { 0x1180, 0x1180, 0x00 }, //   -0.75 dB
+  { 0x1100, 0x1100, 0x00 }, //   -0.50 dB
+  { 0x1080, 0x1080, 0x00 }, //   -0.25 dB
+  { 0x1000, 0x1000, 0x00 }, //   +0.00 dB
+  { 0x4E80, 0x4E80, 0x7E }, //   +0.25 dB
+  { 0x4E00, 0x4E00, 0x7E }, //   +0.50 dB
+  { 0x4D80, 0x4D80, 0x7E }, //   +0.75 dB
+  { 0x4D00, 0x4D00, 0x7E }, //   +1.00 dB
+  { 0x4C80, 0x4C80, 0x7E }, //   +1.25 dB
+  { 0x4C00, 0x4C00, 0x7E }, //   +1.50 dB
+  { 0x4B80, 0x4B80, 0x7E }, //   +1.75 dB
+  { 0x4B00, 0x4B00, 0x7E }, //   +2.00 dB
+  { 0x4A80, 0x4A80, 0x7E }, //   +2.25 dB
+  { 0x4A00, 0x4A00, 0x7E }, //   +2.50 dB
+  { 0x4980, 0x4980, 0x7E }, //   +2.75 dB
+  { 0x4900, 0x4900, 0x7E }, //   +3.00 dB
+  { 0x4880, 0x4880, 0x7E }, //   +3.25 dB
+  { 0x4800, 0x4800, 0x7E }, //   +3.50 dB
+  { 0x4780, 0x4780, 0x7E }, //   +3.75 dB
+  { 0x4700, 0x4700, 0x7E }, //   +4.00 dB
+  { 0x4680, 0x4680, 0x7E }, //   +4.25 dB
+  { 0x4600, 0x4600, 0x7E }, //   +4.50 dB
+  { 0x4580, 0x4580, 0x7E }, //   +4.75 dB
+  { 0x4500, 0x4500, 0x7E }, //   +5.00 dB
+  { 0x4480, 0x4480, 0x7E }, //   +5.25 dB
+  { 0x4400, 0x4400, 0x7E }, //   +5.50 dB
+  { 0x4380, 0x4380, 0x7E }, //   +5.75 dB
+  { 0x4300, 0x4300, 0x7E }, //   +6.00 dB
+  { 0x4280, 0x4280, 0x7E }, //   +6.25 dB
+  { 0x4200, 0x4200, 0x7E }, //   +6.50 dB
+  { 0x4180, 0x4180, 0x7E }, //   +6.75 dB
+  { 0x4100, 0x4100, 0x7E }, //   +7.00 dB
+  { 0x4080, 0x4080, 0x7E }, //   +7.25 dB
+  { 0x4000, 0x4000, 0x7E }, //   +7.50 dB
+  { 0x3F80, 0x3F80, 0x7E }, //   +7.75 dB
+  { 0x3F00, 0x3F00, 0x7E }, //   +8.00 dB
+  { 0x3E80, 0x3E80, 0x7E }, //   +8.25 dB
+  { 0x3E00, 0x3E00, 0x7E }, //   +8.50 dB
+  { 0x3D80, 0x3D80, 0x7E }, //   +8.75 dB
+  { 0x3D00, 0x3D00, 0x7E }, //   +9.00 dB
+  { 0x3C80, 0x3C80, 0x7E }, //   +9.25 dB
+  { 0x3C00, 0x3C00, 0x7E }, //   +9.50 dB
+  { 0x3B80, 0x3B80, 0x7E }, //   +9.75 dB
+  { 0x3B00, 0x3B00, 0x7E }, //  +10.00 dB
+  { 0x3A80, 0x3A80, 0x7E }, //  +10.25 dB
+  { 0x3A00, 0x3A00, 0x7E }, //  +10.50 dB
+  { 0x3980, 0x3980, 0x7E }, //  +10.75 dB
+  { 0x3900, 0x3900, 0x7E }, //  +11.00 dB
+  { 0x3880, 0x3880, 0x7E }, //  +11.25 dB
+  { 0x3800, 0x3800, 0x7E }, //  +11.50 dB
+  { 0x3780, 0x3780, 0x7E }, //  +11.75 dB
+  { 0x3700, 0x3700, 0x7E }, //  +12.00 dB
+  { 0x3680, 0x3680, 0x7E }, //  +12.25 dB
+  { 0x3600, 0x3600, 0x7E }, //  +12.50 dB
+  { 0x3580, 0x3580, 0x7E }, //  +12.75 dB
+  { 0x3500, 0x3500, 0x7E }, //  +13.00 dB
+  { 0x3480, 0x3480, 0x7E }, //  +13.25 dB
+  { 0x3400, 0x3400, 0x7E }, //  +13.50 dB
+  { 0x3380, 0x3380, 0x7E }, //  +13.75 dB
+  { 0x3300, 0x3300, 0x7E }, //  +14.00 dB
+  { 0x3280, 0x3280, 0x7E }, //  +14.25 dB
+  { 0x3200, 0x3200, 0x7E }, //  +14.50 dB
+  { 0x3180, 0x3180, 0x7E }, //  +14.75 dB
+  { 0x3100, 0x3100, 0x7E }, //  +15.00 dB
+  { 0x3080, 0x3080, 0x7E }, //  +15.25 dB
+  { 0x3000, 0x3000, 0x7E }, //  +15.50 dB
+  { 0x2F80, 0x2F80, 0x7E }, //  +15.75 dB
+  { 0x2F00, 0x2F00, 0x7E }, //  +16.00 dB
+  { 0x2E80, 0x2E80, 0x7E }, //  +16.25 dB
+  { 0x2E00, 0x2E00, 0x7E }, //  +16.50 dB
+  { 0x2D80, 0x2D80, 0x7E }, //  +16.75 dB
+  { 0x2D00, 0x2D00, 0x7E }, //  +17.00 dB
+  { 0x2C80, 0x2C80, 0x7E }, //  +17.25 dB
+  { 0x2C00, 0x2C00, 0x7E }, //  +17.50 dB
+  { 0x2B80, 0x2B80, 0x7E }, //  +17.75 dB
+  { 0x2B00, 0x2B00, 0x7E }, //  +18.00 dB
+  { 0x2A80, 0x2A80, 0x7E }, //  +18.25 dB
+  { 0x2A00, 0x2A00, 0x7E }, //  +18.50 dB
+  { 0x2980, 0x2980, 0x7E }, //  +18.75 dB
+  { 0x2900, 0x2900, 0x7E }, //  +19.00 dB
+  { 0x2880, 0x2880, 0x7E }, //  +19.25 dB
+  { 0x2800, 0x2800, 0x7E }, //  +19.50 dB
+  { 0x2780, 0x2780, 0x7E }, //  +19.75 dB
+  { 0x2700, 0x2700, 0x7E }, //  +20.00 dB
+  { 0x2680, 0x2680, 0x7E }, //  +20.25 dB
+  { 0x2600, 0x2600, 0x7E }, //  +20.50 dB
+  { 0x2580, 0x2580, 0x7E }, //  +20.75 dB
+  { 0x2500, 0x2500, 0x7E }, //  +21.00 dB
+  { 0x2480, 0x2480, 0x7E }, //  +21.25 dB
+  { 0x2400, 0x2400, 0x7E }, //  +21.50 dB
+  { 0x2380, 0x2380, 0x7E }, //  +21.75 dB
+  { 0x2300, 0x2300, 0x7E }, //  +22.00 dB
+  { 0x2280, 0x2280, 0x7E }, //  +22.25 dB
+  { 0x2200, 0x2200, 0x7E }, //  +22.50 dB
+  { 0x2180, 0x2180, 0x7E }, //  +22.75 dB
+  { 0x2100, 0x2100, 0x7E }, //  +23.00 dB
+  { 0x2080, 0x2080, 0x7E }, //  +23.25 dB
+  { 0x2000, 0x2000, 0x7E }, //  +23.50 dB
+  { 0x1F80, 0x1F80, 0x7E }, //  +23.75 dB
+  { 0x1F00, 0x1F00, 0x7E }, //  +24.00 dB
+  { 0x1E80, 0x1E80, 0x7E }, //  +24.25 dB
+  { 0x1E00, 0x1E00, 0x7E }, //  +24.50 dB
+  { 0x1D80, 0x1D80, 0x7E }, //  +24.75 dB
+  { 0x1D00, 0x1D00, 0x7E }, //  +25.00 dB
+  { 0x1C80, 0x1C80, 0x7E }, //  +25.25 dB
+  { 0x1C00, 0x1C00, 0x7E }, //  +25.50 dB
+  { 0x1B80, 0x1B80, 0x7E }, //  +25.75 dB
+  { 0x1B00, 0x1B00, 0x7E }, //  +26.00 dB
+  { 0x1A80, 0x1A80, 0x7E }, //  +26.25 dB
+  { 0x1A00, 0x1A00, 0x7E }, //  +26.50 dB
+  { 0x1980, 0x1980, 0x7E }, //  +26.75 dB
+  { 0x1900, 0x1900, 0x7E }, //  +27.00 dB
+  { 0x1880, 0x1880, 0x7E }, //  +27.25 dB
+  { 0x1800, 0x1800, 0x7E }, //  +27.50 dB
+  { 0x1780, 0x1780, 0x7E }, //  +27.75 dB
+  { 0x1700, 0x1700, 0x7E }, //  +28.00 dB
+  { 0x1680, 0x1680, 0x7E }, //  +28.25 dB
+  { 0x1600, 0x1600, 0x7E }, //  +28.50 dB
+  { 0x1580, 0x1580, 0x7E }, //  +28.75 dB
+  { 0x1500, 0x1500, 0x7E }, //  +29.00 dB
+  { 0x1480, 0x1480, 0x7E }, //  +29.25 dB
+  { 0x1400, 0x1400, 0x7E }, //  +29.50 dB
+  { 0x1380, 0x1380, 0x7E }, //  +29.75 dB
+  { 0x1300, 0x1300, 0x7E }, //  +30.00 dB
+  { 0x1280, 0x1280, 0x7E }, //  +30.25 dB
+  { 0x1200, 0x1200, 0x7E }, //  +30.50 dB
+  { 0x1180, 0x1180, 0x7E }, //  +30.75 dB
+  { 0x1100, 0x1100, 0x7E }, //  +31.00 dB
+  { 0x1080, 0x1080, 0x7E }, //  +31.25 dB
+  { 0x1000, 0x1000, 0x7E }, //  +31.50 dB
+};
+}
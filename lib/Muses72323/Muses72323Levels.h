@@ -0,0 +1,26 @@
+// generated by tools/gen_muses_tables.py, do not edit
+
+#ifndef INCLUDED_MUSES_72323_LEVELS
+#define INCLUDED_MUSES_72323_LEVELS
+
+#include <stdint.h>
+
+namespace muses72323 {
+  static const int s_level_min = -447;
+  static const int s_level_max = 126;
+
+  // per-channel trim baked into the table, 0.25 dB steps
+  static const int s_trim_l = 0;
+  static const int s_trim_r = 0;
+
+  // one entry per 0.25 dB level, read from flash with pgm_read_*
+  struct level_plan_t {
+    uint16_t attenuation_l;  // attenuation register data, trim applied
+    uint16_t attenuation_r;
+    uint8_t gain;            // high byte of the gain register data
+  };
+
+  extern const level_plan_t s_level_plan[s_level_max - s_level_min + 1];
+}
+
+#endif // INCLUDED_MUSES_72323_LEVELS
@@ -0,0 +1,100 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2016 Christoffer Hjalmarsson
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy of
+  this software and associated documentation files (the "Software"), to deal in
+  the Software without restriction, including without limitation the rights to
+  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+  the Software, and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+  FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef INCLUDED_MUSES_72323_MOCK
+#define INCLUDED_MUSES_72323_MOCK
+
+#include <stdint.h>
+
+// Transport that records command words instead of sending them, so the
+// driver can be exercised on the host. Capacity words are kept, count keeps
+// going past it so overflows are visible. time only moves when the test
+// advances it.
+//
+// In async mode words stay queued until latch() hands them to the chip,
+// latched counts the ones it has taken and the word at latched is the one
+// shifting out. discard() keeps that one and drops the rest, as the hardware
+// SPI transport does. interrupt, when set, is called once inside the next
+// send() before the word is queued, e.g. to fire urgentMute() mid-frame.
+template <uint16_t Capacity = 64>
+struct Muses72323MockTransport {
+  static uint16_t frames[Capacity];
+  static uint16_t count;
+  static uint16_t bursts;
+  static uint32_t time;
+  static bool async;
+  static uint16_t latched;
+  static void (*interrupt)();
+
+  static const uint8_t frame_us = 0;
+
+  static void begin() { clear(); }
+
+  static void send(uint16_t frame) {
+    if (interrupt) {
+      void (*isr)() = interrupt;
+      interrupt = 0;
+      isr();
+    }
+    if (count < Capacity) {
+      frames[count] = frame;
+    }
+    count++;
+    if (!async) {
+      latched = count;
+    }
+  }
+
+  static void clear() {
+    count = 0;
+    bursts = 0;
+    latched = 0;
+  }
+
+  // the chip takes every queued word
+  static void latch() { latched = count; }
+
+  static void beginBurst() { bursts++; }
+  static void endBurst() {}
+  static void discard() {
+    if (count > latched + 1) {
+      count = latched + 1;
+    }
+  }
+
+  static void setAsync(bool enabled) { async = enabled; }
+  static bool isAsync() { return async; }
+  static bool idle() { return true; }
+  static void flush() {}
+  static uint32_t now() { return time; }
+};
+
+template <uint16_t Capacity> uint16_t Muses72323MockTransport<Capacity>::frames[Capacity];
+template <uint16_t Capacity> uint16_t Muses72323MockTransport<Capacity>::count;
+template <uint16_t Capacity> uint16_t Muses72323MockTransport<Capacity>::bursts;
+template <uint16_t Capacity> uint32_t Muses72323MockTransport<Capacity>::time;
+template <uint16_t Capacity> bool Muses72323MockTransport<Capacity>::async;
+template <uint16_t Capacity> uint16_t Muses72323MockTransport<Capacity>::latched;
+template <uint16_t Capacity> void (*Muses72323MockTransport<Capacity>::interrupt)();
+
+#endif // INCLUDED_MUSES_72323_MOCK
@@ -0,0 +1,388 @@
+/*
+  The MIT License (MIT)
+
+  Copyright (c) 2016 Christoffer Hjalmarsson
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy of
+  this software and associated documentation files (the "Software"), to deal in
+  the Software without restriction, including without limitation the rights to
+  use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+  the Software, and to permit persons to whom the Software is furnished to do so,
+  subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+  FOR A PARTICULAR PURPOSE AND NON INFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+  COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+  IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+  CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef INCLUDED_MUSES_72323_TRANSPORT
+#define INCLUDED_MUSES_72323_TRANSPORT
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <util/atomic.h>
+
+// Transport policies for Muses72323<Transport>. Each one shifts a 16-bit
+// command word out MSB first (SPI mode 0, at most 1 MHz) and raises the
+// latch pin once the word is complete. beginBurst() / endBurst() bracket
+// several words that should go out back to back, and frame_us is the
+// nominal bus time of one word. Estimated cost per word at 16 MHz:
+//
+//   transport                    bus clock   cycles/word   caller blocked
+//   Muses72323HardwareSpi        500 kHz     ~560          ~35 us
+//   Muses72323HardwareSpi async  500 kHz     ~560          ~5 us (+ISR)
+//   Muses72323UsartSpi           800 kHz     ~350          ~22 us
+//   Muses72323BitBang            ~1 MHz      ~290          ~18 us
+//
+// The previous digitalWrite() based latch added ~110 cycles per word.
+// See lib/Muses72323/README.md for the breakdown.
+
+// called from SPI_STC_vect, set by the transport that owns the interrupt
+extern void (*volatile muses72323_spi_isr)();
+
+// a digital pin of the ATmega328P resolved at compile time, so high() and
+// low() compile to single sbi/cbi instructions
+template <uint8_t Pin>
+struct Muses72323Pin {
+  static volatile uint8_t &port() {
+    return Pin < 8 ? PORTD : Pin < 14 ? PORTB : PORTC;
+  }
+  static volatile uint8_t &ddr() {
+    return Pin < 8 ? DDRD : Pin < 14 ? DDRB : DDRC;
+  }
+  static const uint8_t mask = _BV(Pin < 8 ? Pin : Pin < 14 ? Pin - 8 : Pin - 14);
+
+  static inline void output() { ddr() |= mask; }
+  static inline void high() { port() |= mask; }
+  static inline void low() { port() &= ~mask; }
+};
+
+// Bus policy for a chip that has the SPI bus to itself. See SpiBus for an
+// arbiter shared with other devices, it has the same interface.
+struct Muses72323ExclusiveBus {
+  static bool tryAcquire(uint8_t) { return true; }
+  static void acquire(uint8_t) {}
+  static void release(uint8_t) {}
+  static bool held(uint8_t) { return false; }
+  static void setReleaseHook(void (*)()) {}
+};
+
+// Hardware SPI peripheral, blocking or interrupt driven.
+// In async mode words go into a fixed ring and SPI_STC_vect shifts them out
+// one byte per interrupt, toggling the latch between words.
+// Bus arbitrates access when other devices share the SPI bus. Words queued
+// while another device holds it wait until the bus is released. Writers
+// in interrupt context need async mode then, a blocking send would spin.
+template <uint8_t LatchPin, class Bus = Muses72323ExclusiveBus>
+class Muses72323HardwareSpi {
+  public:
+    typedef Muses72323Pin<LatchPin> latch;
+
+    // arbiter device id, the chip select is unique per device
+    static const uint8_t bus_device = LatchPin + 1;
+
+    static const uint8_t frame_us = 35;
+
+    static void begin() {
+      latch::output();
+      latch::high();
+      SPI.begin();
+      Bus::setReleaseHook(resume);
+    }
+
+    static void send(uint16_t frame) {
+      if (async) {
+        push(frame);
+        return;
+      }
+      if (!in_burst) {
+        // never interleave with words still queued from async mode
+        flush();
+        Bus::acquire(bus_device);
+        SPI.beginTransaction(settings());
+      }
+      latch::low();
+      SPI.transfer(highByte(frame));
+      SPI.transfer(lowByte(frame));
+      latch::high();
+      if (!in_burst) {
+        SPI.endTransaction();
+        Bus::release(bus_device);
+      }
+    }
+
+    // send the words between beginBurst() and endBurst() in one SPI
+    // transaction. in async mode they are held back and queued in one go.
+    static void beginBurst() {
+      if (async) {
+        held = true;
+        return;
+      }
+      flush();
+      Bus::acquire(bus_device);
+      SPI.beginTransaction(settings());
+      in_burst = true;
+    }
+
+    static void endBurst() {
+      if (async) {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+          held = false;
+          if (!busy && head != tail) {
+            kick();
+          }
+        }
+        return;
+      }
+      in_burst = false;
+      SPI.endTransaction();
+      Bus::release(bus_device);
+    }
+
+    // drop queued words that have not started shifting out
+    static void discard() {
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        head = busy ? (tail + 1) & (queue_size - 1) : tail;
+      }
+    }
+
+    static void setAsync(bool enabled) {
+      if (!enabled) {
+        flush();
+      }
+      async = enabled;
+    }
+
+    static bool isAsync() { return async; }
+
+    static bool idle() {
+      return !busy && head == tail;
+    }
+
+    static uint32_t now() { return micros(); }
+
+    static void flush() {
+      while (!idle()) {
+        // with interrupts off nothing can release the bus another device
+        // holds, the words go out as soon as it does
+        if (!busy && Bus::held(bus_device) && !bitRead(SREG, SREG_I)) {
+          return;
+        }
+        wait_step();
+      }
+    }
+
+  private:
+    // size must be a power of two, 16 holds a full four chip burst
+    static const uint8_t queue_size = 16;
+
+    static SPISettings settings() {
+      // Muses72323 max clock freq=1MHz, set for 800KHz
+      return SPISettings(800000, MSBFIRST, SPI_MODE0);
+    }
+
+    // drop the latch and start shifting out the word at the tail
+    static inline void start_word() {
+      latch::low();
+      low_byte = true;
+      SPDR = highByte(queue[tail]);
+    }
+
+    // advance the queue after a byte completes. called from SPI_STC_vect,
+    // or by polling SPIF when interrupts are disabled
+    static void service() {
+      if (low_byte) {
+        low_byte = false;
+        SPDR = lowByte(queue[tail]);
+        return;
+      }
+
+      // both bytes are out, latch the word
+      latch::high();
+      tail = (tail + 1) & (queue_size - 1);
+
+      if (tail != head) {
+        start_word();
+      } else {
+        SPCR &= ~_BV(SPIE);
+        SPI.endTransaction();
+        busy = false;
+        Bus::release(bus_device);
+      }
+    }
+
+    // take the bus and start on the word at the tail, or leave the words
+    // queued for resume() if another device holds the bus
+    static inline void kick() {
+      if (!Bus::tryAcquire(bus_device)) {
+        return;
+      }
+      busy = true;
+      muses72323_spi_isr = service;
+      SPI.beginTransaction(settings());
+      SPCR |= _BV(SPIE);
+      start_word();
+    }
+
+    // bus release hook, restart words held back while the bus was taken
+    static void resume() {
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (!busy && !held && head != tail) {
+          kick();
+        }
+      }
+    }
+
+    // make progress on the queue while waiting for it. with interrupts
+    // enabled the ISR does the work, otherwise (e.g. from another ISR) poll.
+    static inline void wait_step() {
+      if (bitRead(SREG, SREG_I)) {
+        return;
+      }
+      if (!busy) {
+        resume();
+      } else if (bitRead(SPSR, SPIF)) {
+        service();
+      }
+    }
+
+    static void push(uint16_t frame) {
+      for (;;) {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+          uint8_t next = (head + 1) & (queue_size - 1);
+          if (next != tail) {
+            queue[head] = frame;
+            head = next;
+            if (!busy && !held) {
+              kick();
+            }
+            return;
+          }
+          // queue is full, it has to drain even inside a burst
+          if (!busy) {
+            kick();
+          }
+        }
+        wait_step();
+      }
+    }
+
+    static bool async;
+    static bool in_burst;           // blocking burst owns the transaction
+    static bool held;               // async burst being queued
+    static volatile uint16_t queue[queue_size];
+    static volatile uint8_t head;   // next free slot
+    static volatile uint8_t tail;   // word being sent
+    static volatile bool busy;      // SPI owned by the queue
+    static volatile bool low_byte;  // high byte sent, low byte next
+};
+
+template <uint8_t LatchPin, class Bus> bool Muses72323HardwareSpi<LatchPin, Bus>::async;
+template <uint8_t LatchPin, class Bus> bool Muses72323HardwareSpi<LatchPin, Bus>::in_burst;
+template <uint8_t LatchPin, class Bus> bool Muses72323HardwareSpi<LatchPin, Bus>::held;
+template <uint8_t LatchPin, class Bus> volatile uint16_t Muses72323HardwareSpi<LatchPin, Bus>::queue[Muses72323HardwareSpi<LatchPin, Bus>::queue_size];
+template <uint8_t LatchPin, class Bus> volatile uint8_t Muses72323HardwareSpi<LatchPin, Bus>::head;
+template <uint8_t LatchPin, class Bus> volatile uint8_t Muses72323HardwareSpi<LatchPin, Bus>::tail;
+template <uint8_t LatchPin, class Bus> volatile bool Muses72323HardwareSpi<LatchPin, Bus>::busy;
+template <uint8_t LatchPin, class Bus> volatile bool Muses72323HardwareSpi<LatchPin, Bus>::low_byte;
+
+// USART0 in master SPI mode (MSPIM). Data leaves on TXD (pin 1) clocked by
+// XCK (pin 4), which leaves the real SPI bus free for other devices. The
+// transmit buffer is double buffered, so both bytes go out back to back.
+template <uint8_t LatchPin>
+class Muses72323UsartSpi {
+  public:
+    typedef Muses72323Pin<LatchPin> latch;
+    typedef Muses72323Pin<4> xck;
+
+    static const uint8_t frame_us = 22;
+
+    static void begin() {
+      latch::output();
+      latch::high();
+      UBRR0 = 0;
+      xck::output();
+      // MSPIM, MSB first, SPI mode 0
+      UCSR0C = _BV(UMSEL01) | _BV(UMSEL00);
+      UCSR0B = _BV(TXEN0);
+      // baud rate is set after enabling the transmitter, 16 MHz / 20 = 800 kHz
+      UBRR0 = 9;
+    }
+
+    static void send(uint16_t frame) {
+      latch::low();
+      UCSR0A = _BV(TXC0);  // clear transmit complete
+      UDR0 = highByte(frame);
+      while (!bitRead(UCSR0A, UDRE0)) {}
+      UDR0 = lowByte(frame);
+      while (!bitRead(UCSR0A, TXC0)) {}
+      latch::high();
+    }
+
+    static void beginBurst() {}
+    static void endBurst() {}
+    static void discard() {}
+    static void setAsync(bool) {}
+    static bool isAsync() { return false; }
+    static bool idle() { return true; }
+    static void flush() {}
+    static uint32_t now() { return micros(); }
+};
+
+// bit-banged on any three pins, padded to stay under the 1 MHz clock limit
+template <uint8_t LatchPin, uint8_t DataPin, uint8_t ClockPin>
+class Muses72323BitBang {
+  public:
+    typedef Muses72323Pin<LatchPin> latch;
+    typedef Muses72323Pin<DataPin> data;
+    typedef Muses72323Pin<ClockPin> clock;
+
+    static const uint8_t frame_us = 18;
+
+    static void begin() {
+      latch::output();
+      latch::high();
+      data::output();
+      clock::output();
+      clock::low();
+    }
+
+    static void send(uint16_t frame) {
+      latch::low();
+      for (uint16_t mask = 0x8000; mask; mask >>= 1) {
+        if (frame & mask) {
+          data::high();
+        } else {
+          data::low();
+        }
+        half_period();
+        clock::high();
+        half_period();
+        clock::low();
+      }
+      latch::high();
+    }
+
+    static void beginBurst() {}
+    static void endBurst() {}
+    static void discard() {}
+    static void setAsync(bool) {}
+    static bool isAsync() { return false; }
+    static bool idle() { return true; }
+    static void flush() {}
+    static uint32_t now() { return micros(); }
+
+  private:
+    static inline void half_period() {
+      // the loop itself takes ~4 cycles per half period
+      __builtin_avr_delay_cycles(4);
+    }
+};
+
+#endif // INCLUDED_MUSES_72323_TRANSPORT
@@ -0,0 +1,145 @@
+#include "Muses72323Model.h"
+#include <Muses72323.h>
+
+typedef Muses72323Model Self;
+
+Muses72323Model *Muses72323ModelTransport::model;
+uint32_t Muses72323ModelTransport::time;
+
+// attenuation code for mute, one step below -111.75 dB (code 479)
+static const uint16_t s_code_muted = 480;
+
+// frame fields, see Muses72323.h
+static const uint16_t s_select_attenuation_l = 0b100;
+static const uint16_t s_select_attenuation_r = 0b101;
+static const uint16_t s_select_gain = 0b010;
+static const uint16_t s_select_states = 0b011;
+
+static inline bool bit(uint16_t frame, uint8_t n)
+{
+  return frame & ((uint16_t)1 << n);
+}
+
+Self::Muses72323Model(uint8_t chip_address, uint16_t frame_us):
+  chip_address(chip_address & 0b11),
+  frame_us(frame_us),
+  gain_code(0),
+  link(false),
+  zero_crossing(true),
+  soft_step(false),
+  soft_step_divider(0),
+  internal_clock(false),
+  frame_count(0),
+  foreign_count(0),
+  first_time(0),
+  last_time(0),
+  mark(0) {
+  // the chip powers up muted
+  for (uint8_t ch = left; ch <= right; ch++) {
+    att[ch] = 0;
+    ramps[ch].from = s_code_muted;
+    ramps[ch].to = s_code_muted;
+    ramps[ch].start = 0;
+    ramps[ch].period = 0;
+  }
+  for (uint8_t i = 0; i < 8; i++) {
+    select_count[i] = 0;
+  }
+}
+
+void Self::receive(uint16_t frame, uint32_t time) {
+  if (!frame_count) {
+    first_time = time;
+  }
+  last_time = time;
+  frame_count++;
+
+  if ((frame & 0b11) != chip_address) {
+    foreign_count++;
+    return;
+  }
+
+  uint8_t select = (frame >> 2) & 0b111;
+  select_count[select]++;
+
+  switch (select) {
+    case s_select_attenuation_l:
+      att[left] = frame & 0xFF80;
+      startRamp(left, att[left] ? att[left] >> 7 : s_code_muted, time);
+      break;
+    case s_select_attenuation_r:
+      att[right] = frame & 0xFF80;
+      if (!link) {
+        startRamp(right, att[right] ? att[right] >> 7 : s_code_muted, time);
+      }
+      break;
+    case s_select_gain: {
+      bool was_linked = link;
+      gain_code = (frame & muses72323::s_gain_mask) >> 9;
+      link = bit(frame, muses72323::s_state_bit_gain);
+      zero_crossing = !bit(frame, muses72323::s_state_bit_zero_crossing);
+      if (was_linked && !link) {
+        // right takes over its own register again
+        startRamp(right, att[right] ? att[right] >> 7 : s_code_muted, time);
+      }
+      break;
+    }
+    case s_select_states:
+      soft_step = bit(frame, muses72323::s_state_soft_step);
+      soft_step_divider = (frame >> muses72323::s_state_soft_step_divider) & 0b111;
+      internal_clock = bit(frame, muses72323::s_state_external_clock);
+      break;
+    default:
+      break;
+  }
+}
+
+void Self::startRamp(channel_t channel, uint16_t code, uint32_t time) {
+  ramp_t &ramp = ramps[channel];
+  ramp.from = codeAt(ramp, time);
+  ramp.to = code;
+  ramp.start = time;
+  ramp.period = soft_step ? muses72323::s_soft_step_base_us << soft_step_divider : 0;
+}
+
+uint16_t Self::codeAt(const ramp_t &ramp, uint32_t time) const {
+  if (!ramp.period || ramp.from == ramp.to) {
+    return ramp.to;
+  }
+  uint32_t steps = (time - ramp.start) / ramp.period;
+  uint16_t distance = ramp.from > ramp.to ? ramp.from - ramp.to : ramp.to - ramp.from;
+  if (steps >= distance) {
+    return ramp.to;
+  }
+  return ramp.from > ramp.to ? ramp.from - steps : ramp.from + steps;
+}
+
+int Self::levelAt(channel_t channel, uint32_t time) const {
+  // linked channels both follow the left register
+  const ramp_t &ramp = ramps[link ? left : channel];
+  uint16_t code = codeAt(ramp, time);
+  if (code >= s_code_muted || code < 32) {
+    return level_muted;
+  }
+  return 32 - (int)code + gain_code * 2;
+}
+
+uint32_t Self::settledAt(channel_t channel) const {
+  const ramp_t &ramp = ramps[link ? left : channel];
+  uint16_t distance = ramp.from > ramp.to ? ramp.from - ramp.to : ramp.to - ramp.from;
+  return ramp.start + (uint32_t)distance * ramp.period;
+}
+
+uint32_t Self::bytesPerSecond() const {
+  uint32_t span = last_time - first_time;
+  if (!span) {
+    return 0;
+  }
+  return (uint32_t)((uint64_t)bytes() * 1000000 / span);
+}
+
+uint32_t Self::takeFrames() {
+  uint32_t taken = frame_count - mark;
+  mark = frame_count;
+  return taken;
+}
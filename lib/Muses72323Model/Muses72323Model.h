@@ -0,0 +1,122 @@
+/* Muses72323 behavioural model
+*******************************
+
+Host side (Linux) model of one MUSES72323 for tests and benchmarks. It
+decodes the 16-bit frames produced by Muses72323<Transport> into register
+writes, keeps the chip state (attenuation, gain, link, zero crossing, soft
+step) and reports the effective level of each channel over simulated time,
+along with how much bus traffic it took to get there.
+
+Drive it with Muses72323ModelTransport:
+
+  Muses72323Model Model(0);
+  Muses72323ModelTransport::model = &Model;
+  Muses72323<Muses72323ModelTransport> Muses(0);
+  Muses.setLevel(-40, -40);
+  Muses72323ModelTransport::time += 50000;
+  Model.levelAt(Muses72323Model::left, Muses72323ModelTransport::time);
+
+Build with g++ -Ilib/Muses72323 -Ilib/Muses72323Model, adding
+Muses72323Model.cpp and Muses72323Levels.cpp.
+
+*/
+
+#ifndef INCLUDED_MUSES_72323_MODEL
+#define INCLUDED_MUSES_72323_MODEL
+
+#include <stdint.h>
+
+class Muses72323Model {
+  public:
+    enum channel_t { left, right };
+
+    // levelAt() for a muted channel
+    static const int level_muted = -32768;
+
+    // model the chip wired to chip_address, frames for other chips are
+    // counted but otherwise ignored. frame_us is the bus time of one frame.
+    explicit Muses72323Model(uint8_t chip_address, uint16_t frame_us = 35);
+
+    // a frame latched at time (microseconds)
+    void receive(uint16_t frame, uint32_t time);
+
+    // effective level in 0.25 dB steps (gain included), or level_muted
+    int levelAt(channel_t channel, uint32_t time) const;
+
+    // time the channel reaches its last written level
+    uint32_t settledAt(channel_t channel) const;
+
+    // register state as last written
+    uint16_t attenuation(channel_t channel) const { return att[channel]; }
+    uint8_t gain() const { return gain_code; }
+    bool linked() const { return link; }
+    bool zeroCrossing() const { return zero_crossing; }
+    bool softStep() const { return soft_step; }
+    uint8_t softStepDivider() const { return soft_step_divider; }
+    bool internalClock() const { return internal_clock; }
+
+    // bus utilisation
+    uint32_t frames() const { return frame_count; }
+    uint32_t foreignFrames() const { return foreign_count; }
+    uint32_t bytes() const { return frame_count * 2; }
+    uint32_t busTime() const { return frame_count * frame_us; }
+    uint32_t writes(uint8_t select) const { return select_count[select & 0b111]; }
+    // bytes per second between the first and the last frame
+    uint32_t bytesPerSecond() const;
+
+    // frames since the last call, e.g. the cost of one user action
+    uint32_t takeFrames();
+
+  private:
+    struct ramp_t {
+      uint16_t from;    // attenuation code, 480 is muted
+      uint16_t to;
+      uint32_t start;
+      uint16_t period;  // microseconds per step, 0 jumps
+    };
+
+    uint16_t codeAt(const ramp_t &ramp, uint32_t time) const;
+    void startRamp(channel_t channel, uint16_t code, uint32_t time);
+
+    uint8_t chip_address;
+    uint16_t frame_us;
+
+    uint16_t att[2];
+    ramp_t ramps[2];
+    uint8_t gain_code;
+    bool link;
+    bool zero_crossing;
+    bool soft_step;
+    uint8_t soft_step_divider;
+    bool internal_clock;
+
+    uint32_t frame_count;
+    uint32_t foreign_count;
+    uint32_t select_count[8];
+    uint32_t first_time;
+    uint32_t last_time;
+    uint32_t mark;
+};
+
+// transport policy that feeds frames into a model on simulated time
+struct Muses72323ModelTransport {
+  static Muses72323Model *model;
+  static uint32_t time;
+  static const uint8_t frame_us = 35;
+
+  static void begin() {}
+  static void send(uint16_t frame) {
+    time += frame_us;
+    model->receive(frame, time);
+  }
+  static void beginBurst() {}
+  static void endBurst() {}
+  static void discard() {}
+  static void setAsync(bool) {}
+  static bool isAsync() { return false; }
+  static bool idle() { return true; }
+  static void flush() {}
+  static uint32_t now() { return time; }
+};
+
+#endif // INCLUDED_MUSES_72323_MODEL
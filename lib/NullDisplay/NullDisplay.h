@@ -0,0 +1,36 @@
+/* Null display
+***************
+
+Takes everything a display backend takes and shows nothing, for headless
+builds and for benchmarks that should time the UI without a bus. room()
+never limits a flush.
+
+*/
+
+#ifndef INCLUDED_NULL_DISPLAY
+#define INCLUDED_NULL_DISPLAY
+
+#include <Arduino.h>
+
+class NullDisplay : public Print {
+  public:
+    void begin() {}
+    void clear() {}
+    void home() {}
+    void setCursor(uint8_t, uint8_t) {}
+
+    virtual size_t write(uint8_t) { return 1; }
+    virtual size_t write(const uint8_t *, size_t size) { return size; }
+    using Print::write;
+
+    void display() {}
+    void noDisplay() {}
+    void backlight() {}
+    void noBacklight() {}
+    void createChar(uint8_t, const uint8_t *) {}
+    uint8_t room() const { return 0xFF; }
+    void command(uint8_t) {}
+    bool ready() const { return true; }
+};
+
+#endif // INCLUDED_NULL_DISPLAY
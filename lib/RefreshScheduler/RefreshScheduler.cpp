@@ -0,0 +1,23 @@
+#include "RefreshScheduler.h"
+
+typedef RefreshScheduler Self;
+
+Self::RefreshScheduler(uint8_t rate):
+  period(1000 / rate),
+  last(0),
+  pending(false) {
+}
+
+bool Self::due() {
+  if (!pending) {
+    return false;
+  }
+  // 16 bits of millis() are plenty for periods below a minute
+  uint16_t now = millis();
+  if ((uint16_t)(now - last) < period) {
+    return false;
+  }
+  last = now;
+  pending = false;
+  return true;
+}
@@ -0,0 +1,37 @@
+/* Display refresh scheduler
+****************************
+
+Rate limits redrawing the display. Control code calls invalidate() whenever
+something shown has changed and carries on, the main loop asks due() and
+renders the latest state only when it returns true. Changes arriving faster
+than the rate are merged into the next frame, intermediate frames are
+dropped rather than queued.
+
+*/
+
+#ifndef INCLUDED_REFRESH_SCHEDULER
+#define INCLUDED_REFRESH_SCHEDULER
+
+#include <Arduino.h>
+
+class RefreshScheduler {
+  public:
+    // at most rate frames per second
+    explicit RefreshScheduler(uint8_t rate);
+
+    // the state shown has changed, render it in the next free slot
+    void invalidate() { pending = true; }
+
+    // true when a frame should be rendered now, at most rate times per
+    // second and only after invalidate()
+    bool due();
+
+    bool isPending() const { return pending; }
+
+  private:
+    uint16_t period;     // ms between frames
+    uint16_t last;       // millis() of the last frame, low 16 bits
+    bool pending;
+};
+
+#endif // INCLUDED_REFRESH_SCHEDULER
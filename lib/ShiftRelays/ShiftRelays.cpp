@@ -0,0 +1,43 @@
+#include "ShiftRelays.h"
+#include <SPI.h>
+#include <SpiBus.h>
+
+typedef ShiftRelays Self;
+
+Self::ShiftRelays(uint8_t latch, uint8_t count):
+  latch(latch),
+  count(min(count, (uint8_t)sizeof(outputs_t))),
+  shadow(0) {
+}
+
+void Self::begin() {
+  pinMode(latch, OUTPUT);
+  digitalWrite(latch, LOW);
+  SPI.begin();
+  shiftOut();
+}
+
+void Self::write(outputs_t outputs) {
+  if (outputs == shadow) {
+    return;
+  }
+  shadow = outputs;
+  shiftOut();
+}
+
+void Self::shiftOut() {
+  // arbiter device id, the latch pin is unique per device
+  SpiBus::acquire(latch + 1);
+  // the 74HC595 shifts at up to 25MHz at 5V, 4MHz keeps long ribbon
+  // cables to the relay board happy
+  SPI.beginTransaction(SPISettings(4000000, MSBFIRST, SPI_MODE0));
+  // the farthest register goes first
+  for (uint8_t i = count; i > 0; i--) {
+    SPI.transfer((uint8_t)(shadow >> (8 * (i - 1))));
+  }
+  // outputs follow the rising edge of RCLK
+  digitalWrite(latch, HIGH);
+  digitalWrite(latch, LOW);
+  SPI.endTransaction();
+  SpiBus::release(latch + 1);
+}
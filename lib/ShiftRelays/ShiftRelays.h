@@ -0,0 +1,41 @@
+/* 74HC595 relay driver
+***********************
+
+Drives source relays from a chain of 74HC595 shift registers on the shared
+SPI bus, one output per relay. Bit 0 is QA of the register nearest the
+Arduino. Up to four registers are supported, 32 relays.
+
+*/
+
+#ifndef INCLUDED_SHIFT_RELAYS
+#define INCLUDED_SHIFT_RELAYS
+
+#include <Arduino.h>
+
+class ShiftRelays {
+  public:
+    typedef uint32_t outputs_t;
+
+    // latch is the RCLK pin of the chain, count the number of registers
+    ShiftRelays(uint8_t latch, uint8_t count);
+
+    // set up the latch pin and clear all outputs
+    void begin();
+
+    // set all outputs, skipped when nothing changed
+    void write(outputs_t outputs);
+
+    // switch exactly one input on, 1 based like the source number
+    void select(uint8_t input) { write((outputs_t)1 << (input - 1)); }
+
+    outputs_t outputs() const { return shadow; }
+
+  private:
+    void shiftOut();
+
+    uint8_t latch;
+    uint8_t count;
+    outputs_t shadow;
+};
+
+#endif // INCLUDED_SHIFT_RELAYS
@@ -0,0 +1,54 @@
+#include "SpiBus.h"
+#include <util/atomic.h>
+
+typedef SpiBus Self;
+
+volatile Self::device_t Self::owner = Self::device_none;
+void (*Self::release_hook)() = 0;
+
+bool Self::tryAcquire(device_t device) {
+  bool taken = false;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if (owner == device_none || owner == device) {
+      owner = device;
+      taken = true;
+    }
+  }
+  return taken;
+}
+
+void Self::acquire(device_t device) {
+  // the burst owner runs its devices' transactions itself
+  if (inBurst()) {
+    return;
+  }
+  while (!tryAcquire(device)) {
+  }
+}
+
+void Self::release(device_t device) {
+  bool freed = false;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if (owner == device) {
+      owner = device_none;
+      freed = true;
+    }
+  }
+  if (freed && release_hook) {
+    release_hook();
+  }
+}
+
+bool Self::held(device_t device) {
+  device_t tmp = owner;
+  return tmp != device_none && tmp != device;
+}
+
+void Self::beginBurst() {
+  while (!tryAcquire(device_burst)) {
+  }
+}
+
+void Self::endBurst() {
+  release(device_burst);
+}
@@ -0,0 +1,56 @@
+/* Shared SPI bus arbiter
+*************************
+
+Serialises transactions of several devices on the one hardware SPI bus,
+e.g. the Muses72323 and a chain of 74HC595 relay drivers. A device takes
+the bus with acquire() or tryAcquire(), runs its own SPISettings and chip
+select, then release()s it. Words a device could not send because the bus
+was taken are restarted from the release hook.
+
+beginBurst() / endBurst() hold the bus across several devices' transactions
+so e.g. a relay change and a volume change go out back to back. acquire()
+inside a burst returns at once, tryAcquire() fails, so interrupt driven
+transfers queue up and go out when the burst ends.
+
+acquire() spins until the bus is free, use it from the main loop only.
+Code in interrupt context has to use tryAcquire() and retry from the hook.
+
+*/
+
+#ifndef INCLUDED_SPI_BUS
+#define INCLUDED_SPI_BUS
+
+#include <Arduino.h>
+
+class SpiBus {
+  public:
+    typedef uint8_t device_t;
+
+    static const device_t device_none = 0;
+    static const device_t device_burst = 0xFF;
+
+    // take the bus if it is free, never blocks
+    static bool tryAcquire(device_t device);
+
+    // take the bus, waiting for the current owner to release it
+    static void acquire(device_t device);
+
+    static void release(device_t device);
+
+    // true if a device other than this one holds the bus
+    static bool held(device_t device);
+
+    static void beginBurst();
+    static void endBurst();
+    static bool inBurst() { return owner == device_burst; }
+
+    // called with the bus free after every release, e.g. to restart an
+    // interrupt driven queue that was held back
+    static void setReleaseHook(void (*hook)()) { release_hook = hook; }
+
+  private:
+    static volatile device_t owner;
+    static void (*release_hook)();
+};
+
+#endif // INCLUDED_SPI_BUS
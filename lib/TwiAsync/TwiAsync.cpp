@@ -0,0 +1,140 @@
+#include "TwiAsync.h"
+#include <util/atomic.h>
+#include <util/twi.h>
+
+typedef TwiAsync Self;
+
+// queued transaction: SLA+W, data length, data bytes
+
+static const uint8_t s_mask = TwiAsync::queue_size - 1;
+
+static const uint8_t s_twcr_next = _BV(TWINT) | _BV(TWEN) | _BV(TWIE);
+
+volatile uint8_t Self::queue[queue_size];
+volatile uint8_t Self::head;
+volatile uint8_t Self::tail;
+volatile uint8_t Self::remaining;
+volatile bool Self::busy;
+volatile uint16_t Self::errors;
+
+ISR(TWI_vect) {
+  TwiAsync::service();
+}
+
+void Self::begin(uint32_t frequency) {
+  // internal pull-ups, as the Wire library does
+  digitalWrite(SDA, HIGH);
+  digitalWrite(SCL, HIGH);
+  setFrequency(frequency);
+  TWCR = _BV(TWEN);
+}
+
+void Self::setFrequency(uint32_t frequency) {
+  flush();
+  // prescaler 1, SCL = F_CPU / (16 + 2 * TWBR)
+  TWSR &= ~(_BV(TWPS0) | _BV(TWPS1));
+  TWBR = ((F_CPU / frequency) - 16) / 2;
+}
+
+bool Self::write(uint8_t address, const uint8_t *data, uint8_t len) {
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    uint8_t used = (head - tail) & s_mask;
+    if (header_size + len > queue_size - 1 - used) {
+      return false;
+    }
+    uint8_t at = head;
+    queue[at] = address << 1;
+    queue[(at + 1) & s_mask] = len;
+    at = (at + header_size) & s_mask;
+    for (uint8_t i = 0; i < len; i++) {
+      queue[at] = data[i];
+      at = (at + 1) & s_mask;
+    }
+    head = at;
+    if (!busy) {
+      kick();
+    }
+  }
+  return true;
+}
+
+void Self::writeWait(uint8_t address, const uint8_t *data, uint8_t len) {
+  while (!write(address, data, len)) {
+    waitStep();
+  }
+}
+
+uint8_t Self::space() {
+  uint8_t used;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    used = (head - tail) & s_mask;
+  }
+  uint8_t free = queue_size - 1 - used;
+  return free > header_size ? free - header_size : 0;
+}
+
+bool Self::idle() {
+  return !busy;
+}
+
+void Self::flush() {
+  while (busy) {
+    waitStep();
+  }
+}
+
+// start the transaction at the tail. called with interrupts disabled
+void Self::kick() {
+  busy = true;
+  // a STOP from the previous transaction may still be going out, it takes
+  // at most one SCL period
+  while (TWCR & _BV(TWSTO)) {
+  }
+  TWCR = s_twcr_next | _BV(TWSTA);
+}
+
+void Self::service() {
+  switch (TW_STATUS) {
+    case TW_START:
+    case TW_REP_START:
+      TWDR = queue[tail];
+      remaining = queue[(tail + 1) & s_mask];
+      tail = (tail + header_size) & s_mask;
+      TWCR = s_twcr_next;
+      return;
+
+    case TW_MT_SLA_ACK:
+    case TW_MT_DATA_ACK:
+      if (remaining) {
+        TWDR = queue[tail];
+        tail = (tail + 1) & s_mask;
+        remaining--;
+        TWCR = s_twcr_next;
+        return;
+      }
+      break;
+
+    default:
+      // NACK, lost arbitration or bus error, drop the rest of it
+      errors++;
+      tail = (tail + remaining) & s_mask;
+      remaining = 0;
+      break;
+  }
+
+  // transaction done, STOP and START the next one if there is one
+  if (head != tail) {
+    TWCR = s_twcr_next | _BV(TWSTO) | _BV(TWSTA);
+  } else {
+    TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWSTO);
+    busy = false;
+  }
+}
+
+// make progress while waiting for the queue. with interrupts enabled the
+// ISR does the work, otherwise (e.g. from another ISR) poll.
+void Self::waitStep() {
+  if (!bitRead(SREG, SREG_I) && busy && (TWCR & _BV(TWINT))) {
+    service();
+  }
+}
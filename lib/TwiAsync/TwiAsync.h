@@ -0,0 +1,66 @@
+/* Interrupt driven TWI master
+******************************
+
+Write-only I2C master for the ATmega328P. write() copies a whole transaction
+into a byte ring and returns at once, TWI_vect sends the queued transactions
+one after the other. The caller only waits when the ring is full, check
+space() first to never wait.
+
+This replaces the Wire library, both use TWI_vect so they cannot be linked
+together.
+
+*/
+
+#ifndef INCLUDED_TWI_ASYNC
+#define INCLUDED_TWI_ASYNC
+
+#include <Arduino.h>
+
+class TwiAsync {
+  public:
+    // size must be a power of two
+    static const uint8_t queue_size = 128;
+
+    // bytes of ring used per transaction on top of its data
+    static const uint8_t header_size = 2;
+
+    static void begin(uint32_t frequency = 100000);
+    static void setFrequency(uint32_t frequency);
+
+    // queue a write of len bytes to the 7-bit address, false (and nothing
+    // queued) when it does not fit. safe to call from interrupts.
+    static bool write(uint8_t address, const uint8_t *data, uint8_t len);
+
+    // like write(), waits for room instead of failing
+    static void writeWait(uint8_t address, const uint8_t *data, uint8_t len);
+
+    // largest transaction write() would take now
+    static uint8_t space();
+
+    static bool idle();
+
+    // wait until everything queued is sent
+    static void flush();
+
+    // transactions dropped after a NACK or bus error
+    static uint16_t getErrors() { return errors; }
+
+    // advance the queue, called from TWI_vect
+    static void service();
+
+    // make progress while waiting for room, e.g. in a loop retrying
+    // write(). polls the TWI when interrupts are disabled.
+    static void waitStep();
+
+  private:
+    static void kick();
+
+    static volatile uint8_t queue[queue_size];
+    static volatile uint8_t head;       // next free byte
+    static volatile uint8_t tail;       // next byte to send
+    static volatile uint8_t remaining;  // data bytes left in the transaction
+    static volatile bool busy;          // TWI owned by the queue
+    static volatile uint16_t errors;
+};
+
+#endif // INCLUDED_TWI_ASYNC
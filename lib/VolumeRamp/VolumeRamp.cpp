@@ -0,0 +1,73 @@
+#include "VolumeRamp.h"
+#include <util/atomic.h>
+
+typedef VolumeRamp Self;
+
+Self::VolumeRamp(uint16_t tick_rate, volume_t initial):
+  tick_rate(tick_rate),
+  slew_rate(tick_rate),
+  accumulator(0),
+  level(initial),
+  goal(initial),
+  forced(false) {
+}
+
+void Self::setSlewRate(uint16_t steps_per_second) {
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    slew_rate = min(steps_per_second, tick_rate);
+  }
+}
+
+void Self::setTarget(volume_t target) {
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    goal = target;
+  }
+}
+
+void Self::jumpTo(volume_t target) {
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    level = target;
+    goal = target;
+    accumulator = 0;
+    forced = true;
+  }
+}
+
+Self::volume_t Self::target() const {
+  volume_t tmp;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    tmp = goal;
+  }
+  return tmp;
+}
+
+bool Self::idle() const {
+  bool tmp;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    tmp = (level == goal) && !forced;
+  }
+  return tmp;
+}
+
+bool Self::tick() {
+  if (level == goal) {
+    accumulator = 0;
+    if (forced) {
+      forced = false;
+      return true;
+    }
+    return false;
+  }
+
+  // bresenham style rate division, one step each time a whole step of
+  // slew has accumulated
+  accumulator += slew_rate;
+  if (accumulator < tick_rate) {
+    return false;
+  }
+  accumulator -= tick_rate;
+
+  level = level < goal ? level + 1 : level - 1;
+  forced = false;
+  return true;
+}
@@ -0,0 +1,54 @@
+/* Volume ramp engine
+*********************
+
+Moves the output level towards a target at a bounded slew rate. tick() is
+called from a fixed rate timer interrupt, so the ramp timing does not depend
+on how long the main loop takes. A new target simply replaces the old one,
+fast encoder spins or held IR keys retarget the ramp rather than queueing.
+
+*/
+
+#ifndef INCLUDED_VOLUME_RAMP
+#define INCLUDED_VOLUME_RAMP
+
+#include <Arduino.h>
+
+class VolumeRamp {
+  public:
+    typedef int volume_t;
+
+    // tick_rate is the frequency tick() is called at, in Hz
+    VolumeRamp(uint16_t tick_rate, volume_t initial);
+
+    // slew rate in 0.25 dB steps per second, at most one step per tick
+    void setSlewRate(uint16_t steps_per_second);
+
+    // ramp towards target from wherever the output is now
+    void setTarget(volume_t target);
+
+    // set the level without ramping, the next tick() reports it so it is
+    // written even if it equals the previous level
+    void jumpTo(volume_t level);
+
+    // have the next tick() report the current level again, e.g. after the
+    // balance applied on top of it has changed
+    void refresh() { forced = true; }
+
+    // advance the ramp, returns true when current() changed and should be
+    // written to the chip. call from the timer interrupt.
+    bool tick();
+
+    volume_t current() const { return level; }
+    volume_t target() const;
+    bool idle() const;
+
+  private:
+    uint16_t tick_rate;
+    uint16_t slew_rate;
+    uint16_t accumulator;  // fraction of a step, in 1/tick_rate units
+    volatile volume_t level;
+    volatile volume_t goal;
+    volatile bool forced;
+};
+
+#endif // INCLUDED_VOLUME_RAMP
@@ -0,0 +1,89 @@
+#include "BarGraph.h"
+#include <avr/pgmspace.h>
+
+#define CELL_FULL 255  // ROM full block
+#define CELL_EMPTY ' ' // ROM space
+#define CELL_MISSING '|' // stands in for a glyph without a slot
+
+// 1 to 4 columns lit, filled from the left then from the right
+const unsigned char bar_l1[8] PROGMEM = {0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000};
+const unsigned char bar_l2[8] PROGMEM = {0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000};
+const unsigned char bar_l3[8] PROGMEM = {0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100};
+const unsigned char bar_l4[8] PROGMEM = {0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110};
+const unsigned char bar_r1[8] PROGMEM = {0b00001, 0b00001, 0b00001, 0b00001, 0b00001, 0b00001, 0b00001, 0b00001};
+const unsigned char bar_r2[8] PROGMEM = {0b00011, 0b00011, 0b00011, 0b00011, 0b00011, 0b00011, 0b00011, 0b00011};
+const unsigned char bar_r3[8] PROGMEM = {0b00111, 0b00111, 0b00111, 0b00111, 0b00111, 0b00111, 0b00111, 0b00111};
+const unsigned char bar_r4[8] PROGMEM = {0b01111, 0b01111, 0b01111, 0b01111, 0b01111, 0b01111, 0b01111, 0b01111};
+
+static const unsigned char *const glyphs[BarGraph::glyph_count] = {
+	bar_l1, bar_l2, bar_l3, bar_l4, bar_r1, bar_r2, bar_r3, bar_r4};
+
+const uint8_t *const *BarGraph::glyphSet()
+{
+	return glyphs;
+}
+
+BarGraph::BarGraph()
+{
+	memset(slots, GlyphCache::none, sizeof(slots));
+}
+
+void BarGraph::release(GlyphCache &cache)
+{
+	for (uint8_t i = 0; i < glyph_count; i++)
+	{
+		cache.release(slots[i]);
+		slots[i] = GlyphCache::none;
+	}
+}
+
+void BarGraph::drawLevel(FrameBuffer &screen, uint8_t row, uint8_t fill)
+{
+	screen.setCursor(0, row);
+	for (uint8_t i = 0; i < cells; i++)
+	{
+		uint8_t start = i * cell_pixels;
+		screen.write(cell(fill > start ? fill - start : 0, false));
+	}
+}
+
+void BarGraph::drawBalance(FrameBuffer &screen, uint8_t row, int8_t offset)
+{
+	const uint8_t half = cells / 2;
+	uint8_t right = offset > 0 ? offset : 0;
+	uint8_t left = offset < 0 ? -offset : 0;
+
+	screen.setCursor(0, row);
+	// left half grows leftwards from the centre
+	for (uint8_t i = 0; i < half; i++)
+	{
+		uint8_t start = (half - 1 - i) * cell_pixels;
+		screen.write(cell(left > start ? left - start : 0, true));
+	}
+	for (uint8_t i = 0; i < half; i++)
+	{
+		uint8_t start = i * cell_pixels;
+		screen.write(cell(right > start ? right - start : 0, false));
+	}
+	if (!offset)
+	{
+		// centred, mark the middle with the column left of it
+		screen.setCursor(half - 1, row);
+		screen.write(cell(1, true));
+	}
+}
+
+// a cell with fill pixels lit from the left or from the right
+uint8_t BarGraph::cell(uint8_t fill, bool fromRight)
+{
+	if (!fill)
+	{
+		return CELL_EMPTY;
+	}
+	if (fill >= cell_pixels)
+	{
+		return CELL_FULL;
+	}
+	uint8_t slot = slots[fill - 1 + (fromRight ? 4 : 0)];
+	return slot == GlyphCache::none ? CELL_MISSING : slot;
+}
@@ -0,0 +1,70 @@
+#include "BigNumerals.h"
+#include "custom.h"
+
+#define DIGIT_BLANK 10	 // a leading zero, drawn as spaces
+#define DIGIT_UNKNOWN 11 // not drawn yet
+
+static const unsigned char *const glyphs[8] = {cc0, cc1, cc2, cc3, cc4, cc5, cc6, cc7};
+static const unsigned char *const rows[4] = {bn1, bn2, bn3, bn4};
+
+const uint8_t *const *BigNumerals::glyphSet()
+{
+	return glyphs;
+}
+
+BigNumerals::BigNumerals(uint8_t col, uint8_t digits) : col(col), digits(min(digits, (uint8_t)max_digits))
+{
+	memset(slots, GlyphCache::none, sizeof(slots));
+	invalidate();
+}
+
+void BigNumerals::release(GlyphCache &cache)
+{
+	for (uint8_t i = 0; i < glyph_count; i++)
+	{
+		cache.release(slots[i]);
+		slots[i] = GlyphCache::none;
+	}
+}
+
+void BigNumerals::draw(FrameBuffer &screen, uint16_t value)
+{
+	// right to left, the units digit is drawn even for zero
+	for (uint8_t position = digits; position > 0; position--)
+	{
+		uint8_t digit = DIGIT_BLANK;
+		if (value || position == digits)
+		{
+			digit = value % 10;
+			value /= 10;
+		}
+		if (digit != shown[position - 1])
+		{
+			drawDigit(screen, position - 1, digit);
+			shown[position - 1] = digit;
+		}
+	}
+}
+
+void BigNumerals::invalidate()
+{
+	memset(shown, DIGIT_UNKNOWN, sizeof(shown));
+}
+
+void BigNumerals::drawDigit(FrameBuffer &screen, uint8_t position, uint8_t digit)
+{
+	for (uint8_t row = 0; row < 4; row++)
+	{
+		screen.setCursor(col + position * digit_width, row);
+		for (uint8_t i = 0; i < digit_width; i++)
+		{
+			uint8_t code = digit == DIGIT_BLANK ? ' ' : pgm_read_byte(&rows[row][digit * digit_width + i]);
+			if (code < glyph_count)
+			{
+				// a custom glyph, a full block stands in if it got no slot
+				code = slots[code] == GlyphCache::none ? 255 : slots[code];
+			}
+			screen.write(code);
+		}
+	}
+}
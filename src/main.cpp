@@ -18,11 +18,28 @@ Ver 2.0 Date	27 April 2022
 
 #include <Arduino.h>
 #include <EEPROM.h>
-#include <LiquidCrystal_I2C.h>
+#if defined(LCD_NONE)
+#include <NullDisplay.h>
+#elif defined(LCD_PARALLEL)
+#include <Hd44780Parallel.h>
+#else
+#include <Hd44780I2c.h>
+#endif
 #include <RC5.h>
 #include <rotary.h>
 #include <Muses72323.h>
-//#include "custom.h"
+#include <Muses72323Transport.h>
+#include <VolumeRamp.h>
+#include <FrameBuffer.h>
+#include <GlyphCache.h>
+#include <RefreshScheduler.h>
+#include <DecibelText.h>
+#ifdef RELAY_SHIFT_REGISTER
+#include <SpiBus.h>
+#include <ShiftRelays.h>
+#endif
+#include "BigNumerals.h"
+#include "BarGraph.h"
 
 #define VERSION_NUM "0.1" // Current software version number
 
@@ -41,6 +58,25 @@ Ver 2.0 Date	27 April 2022
 #define EEPROM_BALANCE 3   // EEPROM location: balance
 
 #define TIME_EXITSELECT 5 //** Time in seconds to exit I/O select mode when no activity
+#define TIME_BARS 3		  // Time in seconds the bar graphs stay up after a balance change
+
+/******* SCREENS *******/
+#define SCREEN_VOLUME 0 // attenuation in big numerals
+#define SCREEN_BARS 1	// volume and balance bar graphs
+
+#define VOLUME_MIN -447 // -111.75dB
+#define VOLUME_MAX 0	// 0dB, up to 126 (+31.5dB) uses the Muses gain stage
+
+#define SCRUB_INTERVAL 250 // ms between background rewrites of one Muses register
+
+#define BALANCE_MAX 40 // balance range, +/-10dB in 0.25dB steps
+
+#define RAMP_TICK_RATE 1000 // volume ramp timer tick, Hz (Timer2)
+#define RAMP_SLEW_RATE 800	// volume ramp slew rate, 0.25dB steps per second
+
+#define DISPLAY_RATE 30 // display redraws per second at most
+
+#define INPUT_COUNT 4 // number of inputs (and inputName entries), more need RELAY_SHIFT_REGISTER
 
 #define printByte(args) write(args);
 
@@ -49,34 +85,72 @@ unsigned long milOnButton;	// Stores last time for switch press
 unsigned long milOnAction;	// Stores last time of user input
 unsigned long milOnFadeIn;	// LCD fade timing
 unsigned long milOnFadeOut; // LCD fade timing
+unsigned long milOnBars;	// Stores last time of a balance change
 
 /********* Global Variables *******************/
-signed int volume;	 // current volume, between 0 and -447
+signed int volume;	 // current volume, between VOLUME_MIN and VOLUME_MAX
+volatile signed char balance; // +ve attenuates left, -ve attenuates right
 unsigned char backlight; // current backlight state
 int counter = 0;
 unsigned char source = 1;	 // current input channel
 unsigned char oldsource = 1; // previous input channel
 unsigned char oldtoggle;
-unsigned char isMuted;	 // current mute status
+volatile unsigned char isMuted; // current mute status
 unsigned char state = 0; // current machine state
 unsigned char buttonState;
 bool btnstate = 0;
 unsigned char oldbtnstate = 0;
 unsigned char rotarystate; // current rotary encoder status
+unsigned char screenMode = SCREEN_VOLUME; // screen to show
+unsigned char glyphMode = SCREEN_VOLUME;  // screen whose glyphs hold the CGRAM slots
 unsigned char result = 0;  // current rotary status
 
 int analogPin = A1;
 
-const char *inputName[] = {
+const char *inputName[INPUT_COUNT] = {
 	"Phono ",
 	"Media ",
 	"CD    ",
 	"Tuner "}; // Elektor i/p board
 
-char buffer1[20] = "";
-
-// LCD construct
-LiquidCrystal_I2C lcd(0x27, 20, 4); // set the LCD address to 0x27 for a 20 chars and 4 line display
+// LCD backend, chosen at build time. Each one has setCursor(), write()
+// of a character or a run, room(), createChar(), begin(), clear(),
+// display()/noDisplay() and backlight()/noBacklight(), the UI only draws
+// into the framebuffer and renders identically on all of them.
+#if defined(LCD_NONE)
+// headless, nothing is shown
+typedef NullDisplay Display;
+Display lcd;
+#elif defined(LCD_PARALLEL)
+// HD44780 in 4-bit mode on spare pins, R/W tied low. the UART pins stay
+// free for Serial and MUSES72323_TRACE
+#ifndef LCD_RS
+#define LCD_RS A0
+#define LCD_EN A2
+#define LCD_D4 A3
+#define LCD_D5 A4
+#define LCD_D6 A5
+#define LCD_D7 9
+#endif
+typedef Hd44780Parallel Display;
+Display lcd(LCD_RS, LCD_EN, LCD_D4, LCD_D5, LCD_D6, LCD_D7, 20, 4);
+#else
+// LCD I2C clock, the PCF8574 is rated for 100kHz, most modules run at 400kHz
+#define LCD_I2C_FREQUENCY 100000
+// PCF8574 backpack, output is queued and sent from the TWI interrupt
+typedef Hd44780I2c Display;
+Display lcd(0x27, 20, 4, LCD_I2C_FREQUENCY); // set the LCD address to 0x27 for a 20 chars and 4 line display
+#endif
+// what the LCD should show, loop() sends the changed cells
+FrameBuffer screen;
+// redraws the screen from the current state at up to DISPLAY_RATE
+RefreshScheduler refresh(DISPLAY_RATE);
+// owner of the eight CGRAM slots
+GlyphCache glyphs;
+// attenuation in whole dB as three big digits on the right of the display
+BigNumerals bigVolume(8, 3);
+// volume and balance at 5 steps per character
+BarGraph bars;
 
 // define encoder pins
 #define encoderPinA 6
@@ -93,8 +167,22 @@ RC5 rc5(IR_PIN);
 // define preAmp control pins
 #define address_Muses 0
 #define muses_CS 10
-// preAmp construct
-Muses72323 Muses(address_Muses, muses_CS);
+#ifdef RELAY_SHIFT_REGISTER
+// source relays on 74HC595s sharing the SPI bus with the Muses
+#define relay_latch 2
+#define relay_registers ((INPUT_COUNT + 7) / 8)
+ShiftRelays relays(relay_latch, relay_registers);
+typedef SpiBus MusesBus;
+#else
+// source relays on pins 1 to INPUT_COUNT, the Muses has the bus to itself
+typedef Muses72323ExclusiveBus MusesBus;
+#endif
+// preAmp construct, hardware SPI with the latch on muses_CS
+typedef Muses72323<Muses72323HardwareSpi<muses_CS, MusesBus> > MusesChip;
+MusesChip Muses(address_Muses);
+
+// volume ramp, advanced from the Timer2 interrupt
+VolumeRamp ramp(RAMP_TICK_RATE, VOLUME_MIN);
 
 // Function prototypes
 void RC5Update(void);
@@ -102,35 +190,59 @@ void setIO();
 void volumeUpdate();
 void buttonPressed();
 void setVolume();
+void setBalance(signed char value);
 void sourceUpdate();
 void mute();
 void unMute();
 void toggleMute();
 void saveIOValues();
+void render();
+void renderVolume();
+void renderBars();
+bool swapGlyphs();
 
 // Powerdown Interrupt service routine
 ISR(ANALOG_COMP_vect)
 {
+	// mute first, the EEPROM and LCD writes below take milliseconds
+	isMuted = 1;		// stop the volume ramp
+	Muses.urgentMute(); // mute at once, never in the middle of a frame
+	Muses.flush();		// make sure the mute is latched before power fails
 	saveIOValues();
 	backlight = STANDBY;
 	lcd.noDisplay();
 	lcd.noBacklight(); // Turn off backlight
-	mute();			   // mute output
 	state = STATE_OFF;
 }
 
+// Volume ramp tick, writes each ramp step to the chip
+ISR(TIMER2_COMPA_vect)
+{
+	if (!isMuted && ramp.tick())
+	{
+		// equal levels let the chip run with linked channels
+		int level = ramp.current();
+		signed char bal = balance;
+		Muses.setLevel(level - (bal > 0 ? bal : 0), level + (bal < 0 ? bal : 0));
+	}
+}
+
 void saveIOValues()
 {
 	EEPROM.update(EEPROM_VOLUME, -volume);
 	EEPROM.update(EEPROM_SOURCE, source);
+	EEPROM.update(EEPROM_BALANCE, balance);
 }
 
 void setIO()
 {
+#ifdef RELAY_SHIFT_REGISTER
+	relays.select(source);
+#else
 	digitalWrite(oldsource, LOW);
 	digitalWrite(source, HIGH);
-	lcd.setCursor(0, 0);
-	lcd.print(inputName[source - 1]);
+#endif
+	refresh.invalidate();
 }
 
 void RotaryUpdate()
@@ -163,7 +275,7 @@ void volumeUpdate()
 		buttonPressed();
 		break;
 	case DIR_CW:
-		if (volume < 0)
+		if (volume < VOLUME_MAX)
 		{
 			if (isMuted)
 			{
@@ -174,7 +286,7 @@ void volumeUpdate()
 		}
 		break;
 	case DIR_CCW:
-		if (volume > -447)
+		if (volume > VOLUME_MIN)
 		{
 			if (isMuted)
 			{
@@ -190,17 +302,105 @@ void volumeUpdate()
 
 void setVolume()
 {
-	Muses.setVolume(volume, volume);
-	double atten = (double(volume) / 4);
-	lcd.setCursor(0,2);
-	lcd.print("         ");
-	lcd.setCursor(0,2);
-	lcd.print("Vol: ");
-	lcd.print(volume);
-	lcd.setCursor(0, 3);
-	lcd.print("Att: ");
-	lcd.print(atten);
-	lcd.print("dB  ");
+	ramp.setTarget(volume);
+	refresh.invalidate();
+}
+
+// draw the whole screen from the current state. only the cells that
+// changed since the last frame reach the LCD.
+void render()
+{
+	if (screenMode != glyphMode)
+	{
+		// blank the LCD first, no cell may show a slot while it is reloaded
+		screen.clear();
+		if (screen.dirty() || !swapGlyphs())
+		{
+			refresh.invalidate();
+			return;
+		}
+	}
+	if (screenMode == SCREEN_BARS)
+	{
+		renderBars();
+	}
+	else
+	{
+		renderVolume();
+	}
+}
+
+// hand the CGRAM slots over to the glyphs of the screen to show. loads
+// only what the display takes without waiting, true once all are in
+bool swapGlyphs()
+{
+	bool loaded;
+	if (screenMode == SCREEN_BARS)
+	{
+		bigVolume.release(glyphs);
+		loaded = bars.acquire(glyphs, lcd);
+	}
+	else
+	{
+		bars.release(glyphs);
+		loaded = bigVolume.acquire(glyphs, lcd);
+	}
+	if (loaded)
+	{
+		glyphMode = screenMode;
+	}
+	return loaded;
+}
+
+void renderVolume()
+{
+	char text[s_decibel_text_size];
+	screen.setCursor(0, 0);
+	screen.print(inputName[source - 1]);
+	screen.setCursor(0, 1);
+	screen.print(isMuted ? F("Muted ") : F("      "));
+	screen.setCursor(0, 2);
+	screen.print(F("Att dB"));
+	screen.setCursor(0, 3);
+	formatQuarterDb(text, volume);
+	screen.print(text);
+	bigVolume.draw(screen, -volume / 4);
+}
+
+void renderBars()
+{
+	char text[s_decibel_text_size];
+	signed char bal = balance;
+	screen.setCursor(0, 0);
+	screen.print(inputName[source - 1]);
+	screen.setCursor(11, 0);
+	if (isMuted)
+	{
+		screen.print(F("  Muted  "));
+	}
+	else
+	{
+		formatQuarterDb(text, volume);
+		screen.print(text);
+		screen.print(F("dB"));
+	}
+	bars.drawLevel(screen, 1, (unsigned int)(volume - VOLUME_MIN) * BarGraph::pixels / (VOLUME_MAX - VOLUME_MIN));
+	screen.setCursor(0, 2);
+	screen.print(F("Balance    "));
+	formatQuarterDb(text, bal);
+	screen.print(text);
+	screen.print(F("dB"));
+	bars.drawBalance(screen, 3, bal * (BarGraph::pixels / 2) / BALANCE_MAX);
+}
+
+void setBalance(signed char value)
+{
+	balance = constrain(value, -BALANCE_MAX, BALANCE_MAX);
+	ramp.refresh();
+	// show the bars for a while
+	screenMode = SCREEN_BARS;
+	milOnBars = millis();
+	refresh.invalidate();
 }
 
 // button pressed routine
@@ -229,7 +429,7 @@ void sourceUpdate()
 	case DIR_CW:
 		oldsource = source;
 		milOnButton = millis();
-		if (oldsource < 4)
+		if (oldsource < INPUT_COUNT)
 		{
 			source++;
 		}
@@ -248,7 +448,7 @@ void sourceUpdate()
 		}
 		else
 		{
-			source = 4;
+			source = INPUT_COUNT;
 		}
 		setIO();
 		break;
@@ -337,7 +537,7 @@ void RC5Update()
 				{
 					unMute();
 				}
-				if (volume < 0)
+				if (volume < VOLUME_MAX)
 				{
 					volume = volume + 1;
 					setVolume();
@@ -349,17 +549,24 @@ void RC5Update()
 				{
 					unMute();
 				}
-				if (volume > -447)
+				if (volume > VOLUME_MIN)
 				{
 					volume = volume - 1;
 					setVolume();
 				}
 				break;
+			case 26:
+				// Balance right
+				setBalance(balance + 1);
+				break;
+			case 27:
+				// Balance left
+				setBalance(balance - 1);
+				break;
 			case 59:
 				// Display Toggle
 				if ((oldtoggle != toggle))
 				{
-					lcd.setCursor(0, 2);
 					if (backlight)
 					{
 						backlight = STANDBY;
@@ -399,18 +606,21 @@ void unMute()
 		backlight = ACTIVE;
 		lcd.backlight(); // Turn on backlight
 	}
+	if (isMuted)
+	{
+		// fade in from the bottom of the range
+		ramp.jumpTo(VOLUME_MIN);
+	}
 	isMuted = 0;
+	Muses.unmute(); // release a power fail mute
 	setVolume();
-	lcd.setCursor(0, 1);
-	lcd.print("      ");
 }
 
 void mute()
 {
 	isMuted = 1;
 	Muses.mute();
-	lcd.setCursor(0, 1);
-	lcd.print("Muted ");
+	refresh.invalidate();
 }
 
 void toggleMute()
@@ -427,36 +637,53 @@ void toggleMute()
 
 void setup()
 {
-	for (size_t pinOut = 1; pinOut < 5; pinOut++)
+#ifdef MUSES72323_TRACE
+	// NB: the UART takes over pin 1, the source 1 relay output unless
+	// the relays run from shift registers (RELAY_SHIFT_REGISTER)
+	Serial.begin(115200);
+#endif
+#ifdef RELAY_SHIFT_REGISTER
+	relays.begin(); // all relays off
+#else
+	for (size_t pinOut = 1; pinOut <= INPUT_COUNT; pinOut++)
 	{
 		pinMode(pinOut, OUTPUT);
 		digitalWrite(pinOut, LOW);
 	}
-	lcd.init();		 // initialize the lcd
+#endif
+	lcd.begin(); // initialize the lcd
 	lcd.backlight(); // turn on LCD backlight
 	backlight = 1;
-	lcd.home(); // LCD cursor to home position
+	// loaded as the TWI queue drains
+	while (!bigVolume.acquire(glyphs, lcd))
+	{
+	}
 
 	// show software version briefly in display
-	lcd.setCursor(0, 3);
-	sprintf(buffer1, "SW ver  " VERSION_NUM);
-	lcd.printstr(buffer1);
+	screen.setCursor(0, 3);
+	screen.print(F("SW ver  " VERSION_NUM));
+	// the glyph uploads above fill the TWI queue, flush() only sends what
+	// fits, so keep going until the whole line is out
+	while (screen.dirty())
+	{
+		screen.flush(lcd);
+	}
 	delay(2000);
-	sprintf(buffer1, "              ");
-	lcd.home();
 
 	// test for first use settings completed. If not, carry out
 	if (EEPROM.read(EEPROM_FIRST_USE))
 	{
 		// Set saved source for first time
 		EEPROM.write(EEPROM_SOURCE, 1);
+		EEPROM.write(EEPROM_BALANCE, 0);
 		EEPROM.write(EEPROM_FIRST_USE, 0x00);
 	}
 
 	// Load source, volume, balance values
 	//volume = -EEPROM.read(EEPROM_VOLUME);
-	volume = -447;
-	source = EEPROM.read(EEPROM_SOURCE);
+	volume = VOLUME_MIN;
+	source = constrain(EEPROM.read(EEPROM_SOURCE), 1, INPUT_COUNT);
+	balance = constrain((signed char)EEPROM.read(EEPROM_BALANCE), -BALANCE_MAX, BALANCE_MAX);
 
 	// AVR native C code for power-down interrupt setup
 	// Setup Analog Compare Interrupt
@@ -468,13 +695,29 @@ void setup()
 
 	// Initialize muses (SPI, pin modes)...
 	Muses.begin();
+	Muses.setAsync(true); // send register writes from the SPI interrupt
+	Muses.setAutoLink(true); // one attenuation word per step while balance is centred
+	Muses.setScrubInterval(SCRUB_INTERVAL);
+	// send the initial register set as one unit
+	Muses.beginCommit();
 	Muses.setExternalClock(false); // must be set!
 	Muses.setZeroCrossingOn(true);
+	Muses.setSoftStep(true); // chip ramps large jumps (unmute, presets) itself
 	Muses.mute();
+	Muses.commit();
 	isMuted = 0;
 	// Load saved settings (source)
 	// set startup volume
+	ramp.setSlewRate(RAMP_SLEW_RATE);
+	ramp.jumpTo(volume);
 	setVolume();
+
+	// AVR native C code for volume ramp timer
+	// Timer2 CTC mode, clk/64, 16MHz / 64 / 250 = 1kHz
+	TCCR2A = (1 << WGM21);
+	TCCR2B = (1 << CS22);
+	OCR2A = (F_CPU / 64 / RAMP_TICK_RATE) - 1;
+	TIMSK2 |= (1 << OCIE2A); // Timer2 compare match A interrupt enable
 	// set source
 	setIO();
 }
@@ -482,4 +725,29 @@ void loop()
 {
 	RC5Update();
 	RotaryUpdate();
+	// render the latest state at most DISPLAY_RATE times a second, the
+	// flush finishes a frame the TWI queue had no room for. a screen
+	// switch renders on every pass until its glyphs are loaded
+	if (screenMode != glyphMode || refresh.due())
+	{
+		render();
+	}
+	screen.flush(lcd);
+	if (screenMode == SCREEN_BARS && (millis() - milOnBars) > TIME_BARS * 1000)
+	{
+		screenMode = SCREEN_VOLUME;
+		refresh.invalidate();
+	}
+	// refresh the write-only Muses registers while the volume is not moving
+	if (ramp.idle())
+	{
+		Muses.scrub();
+	}
+#ifdef MUSES72323_TRACE
+	// drain one trace record per pass once the bus is quiet
+	if (Muses.idle() && Serial.availableForWrite() >= MusesChip::trace_frame_size)
+	{
+		Muses.traceDrain(Serial, 1);
+	}
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,80 @@
+/* Arduino core for host tests
+******************************
+
+Just enough of the Arduino core and the ATmega328P registers for the
+libraries under test to build natively ([env:native] in platformio.ini).
+Registers are plain variables the tests drive by hand, time only moves when
+a test advances host_time_us or something polls micros().
+
+*/
+
+#ifndef INCLUDED_HOST_ARDUINO
+#define INCLUDED_HOST_ARDUINO
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+
+typedef uint8_t byte;
+typedef uint16_t word;
+typedef bool boolean;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define F_CPU 16000000UL
+
+static const uint8_t SDA = 18;
+static const uint8_t SCL = 19;
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+
+template <class T> T min(T a, T b) { return a < b ? a : b; }
+template <class T> T max(T a, T b) { return a > b ? a : b; }
+
+// simulated time. every micros() call costs 4us, the resolution of the
+// real one, so polling loops make progress
+inline uint32_t host_time_us;
+inline unsigned long micros() { return host_time_us += 4; }
+inline unsigned long millis() { return host_time_us / 1000; }
+inline void delay(unsigned long ms) { host_time_us += ms * 1000; }
+inline void delayMicroseconds(unsigned int us) { host_time_us += us; }
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+
+class __FlashStringHelper;
+#define F(text) ((const __FlashStringHelper *)(text))
+
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t value) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) {
+      size_t n = 0;
+      while (size--) {
+        n += write(*buffer++);
+      }
+      return n;
+    }
+    size_t write(const char *text) { return write((const uint8_t *)text, strlen(text)); }
+    size_t print(const char *text) { return write(text); }
+    size_t print(const __FlashStringHelper *text) { return write((const char *)text); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(long value) {
+      char text[12];
+      snprintf(text, sizeof(text), "%ld", value);
+      return write(text);
+    }
+    size_t print(int value) { return print((long)value); }
+};
+
+#endif // INCLUDED_HOST_ARDUINO
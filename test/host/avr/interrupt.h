@@ -0,0 +1,12 @@
+#ifndef INCLUDED_HOST_AVR_INTERRUPT
+#define INCLUDED_HOST_AVR_INTERRUPT
+
+#include <avr/io.h>
+
+#define cli() (SREG &= ~_BV(SREG_I))
+#define sei() (SREG |= _BV(SREG_I))
+
+// the handler becomes a plain function a test can call
+#define ISR(vector) extern "C" void vector(void)
+
+#endif // INCLUDED_HOST_AVR_INTERRUPT
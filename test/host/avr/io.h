@@ -0,0 +1,27 @@
+// ATmega328P registers used by the libraries, as plain variables
+
+#ifndef INCLUDED_HOST_AVR_IO
+#define INCLUDED_HOST_AVR_IO
+
+#include <stdint.h>
+
+#define _BV(bit) (1 << (bit))
+
+inline volatile uint8_t SREG;
+inline volatile uint8_t TWCR;
+inline volatile uint8_t TWSR;
+inline volatile uint8_t TWBR;
+inline volatile uint8_t TWDR;
+
+#define SREG_I 7
+
+#define TWINT 7
+#define TWEA 6
+#define TWSTA 5
+#define TWSTO 4
+#define TWEN 2
+#define TWIE 0
+#define TWPS1 1
+#define TWPS0 0
+
+#endif // INCLUDED_HOST_AVR_IO
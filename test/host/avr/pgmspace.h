@@ -0,0 +1,11 @@
+#ifndef INCLUDED_HOST_AVR_PGMSPACE
+#define INCLUDED_HOST_AVR_PGMSPACE
+
+#include <string.h>
+
+#define PROGMEM
+#define memcpy_P memcpy
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_word(address) (*(const uint16_t *)(address))
+
+#endif // INCLUDED_HOST_AVR_PGMSPACE
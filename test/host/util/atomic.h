@@ -0,0 +1,18 @@
+#ifndef INCLUDED_HOST_UTIL_ATOMIC
+#define INCLUDED_HOST_UTIL_ATOMIC
+
+#include <avr/interrupt.h>
+
+// runs the block once with I cleared, then puts SREG back
+struct host_atomic_restore {
+  uint8_t sreg;
+  bool once;
+  host_atomic_restore(): sreg(SREG), once(true) { cli(); }
+  ~host_atomic_restore() { SREG = sreg; }
+};
+
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_BLOCK(type) \
+  for (host_atomic_restore host_atomic; host_atomic.once; host_atomic.once = false)
+
+#endif // INCLUDED_HOST_UTIL_ATOMIC
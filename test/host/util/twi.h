@@ -0,0 +1,14 @@
+#ifndef INCLUDED_HOST_UTIL_TWI
+#define INCLUDED_HOST_UTIL_TWI
+
+#include <avr/io.h>
+
+#define TW_STATUS (TWSR & 0xF8)
+#define TW_START 0x08
+#define TW_REP_START 0x10
+#define TW_MT_SLA_ACK 0x18
+#define TW_MT_SLA_NACK 0x20
+#define TW_MT_DATA_ACK 0x28
+#define TW_MT_DATA_NACK 0x30
+
+#endif // INCLUDED_HOST_UTIL_TWI
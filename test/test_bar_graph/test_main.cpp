@@ -0,0 +1,133 @@
+// Host tests for BarGraph (src/BarGraph.cpp), run with pio test -e native.
+// Rows are drawn into a FrameBuffer and flushed into a fake display that
+// keeps the character cells.
+
+#include <unity.h>
+#include <Arduino.h>
+#include <BarGraph.h>
+
+static const uint8_t full = 255;
+
+// the cells as the LCD would show them
+struct FakeDisplay {
+  uint8_t cells[FrameBuffer::rows][FrameBuffer::cols];
+  uint8_t col;
+  uint8_t row;
+  uint16_t writes;
+
+  FakeDisplay(): col(0), row(0), writes(0) { memset(cells, ' ', sizeof(cells)); }
+
+  void setCursor(uint8_t c, uint8_t r) {
+    col = c;
+    row = r;
+  }
+  size_t write(const uint8_t *buffer, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      cells[row][col++] = buffer[i];
+    }
+    writes += size;
+    return size;
+  }
+  void createChar(uint8_t, const uint8_t *) {}
+  uint8_t room() const { return 0xFF; }
+};
+
+static GlyphCache *cache;
+static BarGraph *bars;
+static FakeDisplay *lcd;
+static FrameBuffer *screen;
+
+// slot of glyph 0..7 (left fills 1-4, right fills 1-4)
+static uint8_t slotOf(uint8_t glyph) {
+  return cache->find(BarGraph::glyphSet()[glyph]);
+}
+
+void setUp() {
+  cache = new GlyphCache();
+  bars = new BarGraph();
+  lcd = new FakeDisplay();
+  screen = new FrameBuffer();
+  TEST_ASSERT_TRUE(bars->acquire(*cache, *lcd));
+}
+
+void tearDown() {
+  delete screen;
+  delete lcd;
+  delete bars;
+  delete cache;
+}
+
+void test_level_fills_from_the_left() {
+  bars->drawLevel(*screen, 1, 7);
+  screen->flush(*lcd);
+  TEST_ASSERT_EQUAL_UINT8(full, lcd->cells[1][0]);
+  TEST_ASSERT_EQUAL_UINT8(slotOf(1), lcd->cells[1][1]);
+  TEST_ASSERT_EQUAL_UINT8(' ', lcd->cells[1][2]);
+  TEST_ASSERT_EQUAL_UINT8(' ', lcd->cells[1][19]);
+}
+
+void test_level_ends() {
+  bars->drawLevel(*screen, 1, BarGraph::pixels);
+  screen->flush(*lcd);
+  for (uint8_t c = 0; c < BarGraph::cells; c++) {
+    TEST_ASSERT_EQUAL_UINT8(full, lcd->cells[1][c]);
+  }
+  bars->drawLevel(*screen, 1, 0);
+  screen->flush(*lcd);
+  for (uint8_t c = 0; c < BarGraph::cells; c++) {
+    TEST_ASSERT_EQUAL_UINT8(' ', lcd->cells[1][c]);
+  }
+}
+
+void test_level_step_sends_one_cell() {
+  bars->drawLevel(*screen, 1, 37);
+  screen->flush(*lcd);
+  uint16_t writes = lcd->writes;
+  bars->drawLevel(*screen, 1, 38);
+  screen->flush(*lcd);
+  TEST_ASSERT_EQUAL_UINT16(writes + 1, lcd->writes);
+  TEST_ASSERT_EQUAL_UINT8(slotOf(2), lcd->cells[1][7]);
+}
+
+void test_balance_centred_marks_the_middle() {
+  bars->drawBalance(*screen, 3, 0);
+  screen->flush(*lcd);
+  for (uint8_t c = 0; c < BarGraph::cells; c++) {
+    TEST_ASSERT_EQUAL_UINT8(c == 9 ? slotOf(4) : ' ', lcd->cells[3][c]);
+  }
+}
+
+void test_balance_grows_from_the_centre() {
+  bars->drawBalance(*screen, 3, 7);
+  screen->flush(*lcd);
+  TEST_ASSERT_EQUAL_UINT8(' ', lcd->cells[3][9]);
+  TEST_ASSERT_EQUAL_UINT8(full, lcd->cells[3][10]);
+  TEST_ASSERT_EQUAL_UINT8(slotOf(1), lcd->cells[3][11]);
+  TEST_ASSERT_EQUAL_UINT8(' ', lcd->cells[3][12]);
+
+  // leftwards the partial cell is filled from the right
+  bars->drawBalance(*screen, 3, -8);
+  screen->flush(*lcd);
+  TEST_ASSERT_EQUAL_UINT8(full, lcd->cells[3][9]);
+  TEST_ASSERT_EQUAL_UINT8(slotOf(6), lcd->cells[3][8]);
+  TEST_ASSERT_EQUAL_UINT8(' ', lcd->cells[3][7]);
+  TEST_ASSERT_EQUAL_UINT8(' ', lcd->cells[3][10]);
+}
+
+void test_missing_glyphs_are_drawn_as_a_bar() {
+  bars->release(*cache);
+  bars->drawLevel(*screen, 1, 2);
+  screen->flush(*lcd);
+  TEST_ASSERT_EQUAL_UINT8('|', lcd->cells[1][0]);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_level_fills_from_the_left);
+  RUN_TEST(test_level_ends);
+  RUN_TEST(test_level_step_sends_one_cell);
+  RUN_TEST(test_balance_centred_marks_the_middle);
+  RUN_TEST(test_balance_grows_from_the_centre);
+  RUN_TEST(test_missing_glyphs_are_drawn_as_a_bar);
+  return UNITY_END();
+}
@@ -0,0 +1,117 @@
+// Host tests for BigNumerals (src/BigNumerals.cpp), run with pio test -e
+// native. Digits are drawn into a FrameBuffer and flushed into a fake
+// display that keeps the character cells.
+
+#include <unity.h>
+#include <Arduino.h>
+#include <BigNumerals.h>
+
+static const uint8_t full = 255;
+
+// the cells as the LCD would show them
+struct FakeDisplay {
+  uint8_t cells[FrameBuffer::rows][FrameBuffer::cols];
+  uint8_t col;
+  uint8_t row;
+
+  FakeDisplay(): col(0), row(0) { memset(cells, ' ', sizeof(cells)); }
+
+  void setCursor(uint8_t c, uint8_t r) {
+    col = c;
+    row = r;
+  }
+  size_t write(const uint8_t *buffer, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      cells[row][col++] = buffer[i];
+    }
+    return size;
+  }
+  void createChar(uint8_t, const uint8_t *) {}
+  uint8_t room() const { return 0xFF; }
+};
+
+static GlyphCache *cache;
+static BigNumerals *big;
+static FakeDisplay *lcd;
+static FrameBuffer *screen;
+
+// slot of glyph 0..7 of custom.h
+static uint8_t slotOf(uint8_t glyph) {
+  return cache->find(BigNumerals::glyphSet()[glyph]);
+}
+
+void setUp() {
+  cache = new GlyphCache();
+  big = new BigNumerals(8, 3);
+  lcd = new FakeDisplay();
+  screen = new FrameBuffer();
+  TEST_ASSERT_TRUE(big->acquire(*cache, *lcd));
+}
+
+void tearDown() {
+  delete screen;
+  delete lcd;
+  delete big;
+  delete cache;
+}
+
+void test_digits_use_the_acquired_slots() {
+  big->draw(*screen, 23);
+  screen->flush(*lcd);
+
+  // leading zero blank, '2' at column 12, '3' at column 16
+  for (uint8_t c = 8; c < 12; c++) {
+    TEST_ASSERT_EQUAL_UINT8(' ', lcd->cells[0][c]);
+  }
+  // top of a 2: glyphs 5, 2, 2, 1
+  TEST_ASSERT_EQUAL_UINT8(slotOf(5), lcd->cells[0][12]);
+  TEST_ASSERT_EQUAL_UINT8(slotOf(2), lcd->cells[0][13]);
+  TEST_ASSERT_EQUAL_UINT8(slotOf(2), lcd->cells[0][14]);
+  TEST_ASSERT_EQUAL_UINT8(slotOf(1), lcd->cells[0][15]);
+  // third row of a 3: spaces then a full block
+  TEST_ASSERT_EQUAL_UINT8(' ', lcd->cells[2][16]);
+  TEST_ASSERT_EQUAL_UINT8(full, lcd->cells[2][19]);
+}
+
+void test_zero_keeps_the_units_digit() {
+  big->draw(*screen, 0);
+  screen->flush(*lcd);
+  TEST_ASSERT_EQUAL_UINT8(' ', lcd->cells[0][12]);
+  // top of a 0: glyphs 5, 2, 2, 1
+  TEST_ASSERT_EQUAL_UINT8(slotOf(5), lcd->cells[0][16]);
+  TEST_ASSERT_EQUAL_UINT8(full, lcd->cells[1][16]);
+}
+
+void test_only_changed_digits_are_redrawn() {
+  big->draw(*screen, 23);
+  // scribble over the tens digit, as another widget would
+  screen->setCursor(12, 0);
+  screen->print('x');
+  big->draw(*screen, 24);
+  screen->flush(*lcd);
+  TEST_ASSERT_EQUAL_UINT8('x', lcd->cells[0][12]);
+
+  // after invalidate() every position is drawn again
+  big->invalidate();
+  big->draw(*screen, 24);
+  screen->flush(*lcd);
+  TEST_ASSERT_EQUAL_UINT8(slotOf(5), lcd->cells[0][12]);
+}
+
+void test_missing_glyphs_are_drawn_full() {
+  big->release(*cache);
+  big->invalidate();
+  big->draw(*screen, 2);
+  screen->flush(*lcd);
+  TEST_ASSERT_EQUAL_UINT8(full, lcd->cells[0][16]);
+  TEST_ASSERT_EQUAL_UINT8(' ', lcd->cells[1][16]);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_digits_use_the_acquired_slots);
+  RUN_TEST(test_zero_keeps_the_units_digit);
+  RUN_TEST(test_only_changed_digits_are_redrawn);
+  RUN_TEST(test_missing_glyphs_are_drawn_full);
+  return UNITY_END();
+}
@@ -0,0 +1,57 @@
+// Host tests for formatQuarterDb(), run with pio test -e native.
+// Every int16 input is compared with printf formatting the level in dB.
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <DecibelText.h>
+
+// what formatQuarterDb() should write, via printf
+static int reference(char *text, int quarters, int width) {
+  char number[16];
+  snprintf(number, sizeof(number), quarters > 0 ? "%+.2f" : "%.2f",
+           quarters / 4.0);
+  return snprintf(text, 24, "%*s", width, number);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_matches_printf_for_every_level() {
+  char text[24];
+  char expected[24];
+  for (int32_t q = INT16_MIN; q <= INT16_MAX; q++) {
+    uint8_t length = formatQuarterDb(text, (int16_t)q);
+    int expected_length = reference(expected, q, 7);
+    TEST_ASSERT_EQUAL_STRING(expected, text);
+    TEST_ASSERT_EQUAL_INT(expected_length, length);
+  }
+}
+
+void test_examples() {
+  char text[s_decibel_text_size];
+  formatQuarterDb(text, -95);
+  TEST_ASSERT_EQUAL_STRING(" -23.75", text);
+  formatQuarterDb(text, 0);
+  TEST_ASSERT_EQUAL_STRING("   0.00", text);
+  formatQuarterDb(text, 126);
+  TEST_ASSERT_EQUAL_STRING(" +31.50", text);
+  formatQuarterDb(text, INT16_MIN);
+  TEST_ASSERT_EQUAL_STRING("-8192.00", text);
+}
+
+void test_width() {
+  char text[24];
+  TEST_ASSERT_EQUAL_UINT8(5, formatQuarterDb(text, -1, 0));
+  TEST_ASSERT_EQUAL_STRING("-0.25", text);
+  TEST_ASSERT_EQUAL_UINT8(10, formatQuarterDb(text, 2, 10));
+  TEST_ASSERT_EQUAL_STRING("     +0.50", text);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_matches_printf_for_every_level);
+  RUN_TEST(test_examples);
+  RUN_TEST(test_width);
+  return UNITY_END();
+}
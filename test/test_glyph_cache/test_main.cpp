@@ -0,0 +1,175 @@
+// Host tests for GlyphCache, run with pio test -e native.
+
+#include <unity.h>
+#include <Arduino.h>
+#include <GlyphCache.h>
+
+// records the CGRAM loads, each one takes load_room of room()
+struct FakeDisplay {
+  uint8_t cgram[GlyphCache::slots][8];
+  uint8_t loads;
+  uint8_t space;
+
+  FakeDisplay(): loads(0), space(0xFF) {}
+
+  void createChar(uint8_t slot, const uint8_t glyph[8]) {
+    memcpy(cgram[slot], glyph, 8);
+    loads++;
+    space = space > GlyphCache::load_room ? space - GlyphCache::load_room : 0;
+  }
+
+  uint8_t room() const { return space; }
+};
+
+// twelve distinct glyphs, the first byte tells them apart
+static const uint8_t s_glyphs[12][8] PROGMEM = {
+  {0}, {1}, {2}, {3}, {4}, {5}, {6}, {7}, {8}, {9}, {10}, {11}
+};
+
+static const uint8_t *const s_numerals[8] = {
+  s_glyphs[0], s_glyphs[1], s_glyphs[2], s_glyphs[3],
+  s_glyphs[4], s_glyphs[5], s_glyphs[6], s_glyphs[7]
+};
+
+static const uint8_t *const s_others[4] = {
+  s_glyphs[8], s_glyphs[9], s_glyphs[10], s_glyphs[11]
+};
+
+static void releaseAll(GlyphCache &cache, uint8_t *slots, uint8_t count) {
+  for (uint8_t i = 0; i < count; i++) {
+    cache.release(slots[i]);
+    slots[i] = GlyphCache::none;
+  }
+}
+
+// slot arrays start out empty, as acquireSet() expects
+static void empty(uint8_t *slots, uint8_t count) {
+  memset(slots, GlyphCache::none, count);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_resident_glyph_is_not_reloaded() {
+  GlyphCache cache;
+  FakeDisplay lcd;
+  uint8_t slot = cache.acquire(lcd, s_glyphs[0]);
+  TEST_ASSERT_EQUAL_UINT8(slot, cache.acquire(lcd, s_glyphs[0]));
+  TEST_ASSERT_EQUAL_UINT16(1, cache.getLoads());
+  TEST_ASSERT_EQUAL_UINT8(1, lcd.loads);
+  TEST_ASSERT_EQUAL_UINT8(0, lcd.cgram[slot][0]);
+
+  cache.release(slot);
+  cache.release(slot);
+  TEST_ASSERT_EQUAL_UINT8(slot, cache.find(s_glyphs[0]));
+}
+
+void test_referenced_glyphs_are_never_evicted() {
+  GlyphCache cache;
+  FakeDisplay lcd;
+  uint8_t slots[8];
+  empty(slots, 8);
+  cache.acquireSet(lcd, s_numerals, 8, slots);
+  TEST_ASSERT_EQUAL_UINT8(GlyphCache::none, cache.acquire(lcd, s_glyphs[8]));
+  TEST_ASSERT_EQUAL_UINT16(8, cache.getLoads());
+
+  // one released: only that slot is taken
+  cache.release(slots[5]);
+  TEST_ASSERT_EQUAL_UINT8(slots[5], cache.acquire(lcd, s_glyphs[8]));
+  TEST_ASSERT_EQUAL_UINT8(8, lcd.cgram[slots[5]][0]);
+  TEST_ASSERT_EQUAL_UINT8(GlyphCache::none, cache.find(s_glyphs[5]));
+}
+
+void test_least_recently_used_is_evicted() {
+  GlyphCache cache;
+  FakeDisplay lcd;
+  uint8_t slots[8];
+  empty(slots, 8);
+  cache.acquireSet(lcd, s_numerals, 8, slots);
+  uint8_t loaded[8];
+  memcpy(loaded, slots, sizeof(loaded));
+  releaseAll(cache, slots, 8);
+  // touch glyph 0 again, glyph 1 is now the oldest
+  cache.release(cache.acquire(lcd, s_glyphs[0]));
+
+  uint8_t slot = cache.acquire(lcd, s_glyphs[8]);
+  TEST_ASSERT_EQUAL_UINT8(loaded[1], slot);
+  TEST_ASSERT_EQUAL_UINT8(loaded[0], cache.find(s_glyphs[0]));
+}
+
+void test_switching_sets_reloads_only_what_was_pushed_out() {
+  GlyphCache cache;
+  FakeDisplay lcd;
+  uint8_t numerals[8];
+  uint8_t others[4];
+  empty(numerals, 8);
+  empty(others, 4);
+
+  cache.acquireSet(lcd, s_numerals, 8, numerals);
+  releaseAll(cache, numerals, 8);
+  cache.acquireSet(lcd, s_others, 4, others);
+  releaseAll(cache, others, 4);
+  cache.acquireSet(lcd, s_numerals, 8, numerals);
+
+  // 8 numerals, 4 others over the oldest numerals, those 4 again
+  TEST_ASSERT_EQUAL_UINT16(16, cache.getLoads());
+  for (uint8_t i = 0; i < 8; i++) {
+    TEST_ASSERT_EQUAL_UINT8(i, lcd.cgram[numerals[i]][0]);
+  }
+}
+
+void test_loads_wait_for_room() {
+  GlyphCache cache;
+  FakeDisplay lcd;
+  uint8_t slots[8];
+  empty(slots, 8);
+
+  // room for two loads per pass, as a drained TWI queue has
+  lcd.space = 2 * GlyphCache::load_room;
+  TEST_ASSERT_FALSE(cache.acquireSet(lcd, s_numerals, 8, slots));
+  TEST_ASSERT_EQUAL_UINT8(2, lcd.loads);
+  TEST_ASSERT_EQUAL_UINT8(GlyphCache::none, slots[2]);
+
+  uint8_t passes = 1;
+  do {
+    lcd.space = 2 * GlyphCache::load_room;
+    passes++;
+  } while (!cache.acquireSet(lcd, s_numerals, 8, slots));
+  TEST_ASSERT_EQUAL_UINT8(4, passes);
+  TEST_ASSERT_EQUAL_UINT8(8, lcd.loads);
+  for (uint8_t i = 0; i < 8; i++) {
+    TEST_ASSERT_EQUAL_UINT8(i, lcd.cgram[slots[i]][0]);
+  }
+
+  // resident glyphs need no room, and kept slots are not referenced twice
+  lcd.space = 0;
+  uint8_t again[8];
+  empty(again, 8);
+  TEST_ASSERT_TRUE(cache.acquireSet(lcd, s_numerals, 8, again));
+  releaseAll(cache, again, 8);
+  releaseAll(cache, slots, 8);
+  TEST_ASSERT_TRUE(cache.acquire(lcd, s_glyphs[8]) != GlyphCache::none);
+}
+
+void test_invalidate_forgets_everything() {
+  GlyphCache cache;
+  FakeDisplay lcd;
+  uint8_t slots[8];
+  empty(slots, 8);
+  cache.acquireSet(lcd, s_numerals, 8, slots);
+  cache.invalidate();
+  TEST_ASSERT_EQUAL_UINT8(GlyphCache::none, cache.find(s_glyphs[0]));
+  TEST_ASSERT_TRUE(cache.acquire(lcd, s_glyphs[8]) != GlyphCache::none);
+  TEST_ASSERT_EQUAL_UINT16(9, cache.getLoads());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_resident_glyph_is_not_reloaded);
+  RUN_TEST(test_referenced_glyphs_are_never_evicted);
+  RUN_TEST(test_least_recently_used_is_evicted);
+  RUN_TEST(test_switching_sets_reloads_only_what_was_pushed_out);
+  RUN_TEST(test_loads_wait_for_room);
+  RUN_TEST(test_invalidate_forgets_everything);
+  return UNITY_END();
+}
@@ -0,0 +1,204 @@
+// Host tests for Hd44780I2c on TwiAsync, run with pio test -e native.
+// drain() plays the TWI hardware with a PCF8574 that acknowledges every
+// byte, and records each transaction as the expander receives it.
+
+#include <unity.h>
+#include <Arduino.h>
+#include <util/twi.h>
+#include <TwiAsync.h>
+#include <Hd44780I2c.h>
+#include <FrameBuffer.h>
+
+static const uint8_t address = 0x27;
+
+// PCF8574 outputs, as the driver maps them
+static const uint8_t rs = 0x01;
+static const uint8_t en = 0x04;
+static const uint8_t bl = 0x08;
+
+struct transaction_t {
+  uint8_t sla;
+  uint8_t length;
+  uint8_t bytes[TwiAsync::queue_size];
+};
+
+static transaction_t sent[8];
+static uint8_t sent_count;
+
+// run the bus until the queue is empty. interrupts stay disabled, so the
+// driver never polls the TWI itself while a test holds the bus.
+static void drain() {
+  bool addressed = false;
+  while (!TwiAsync::idle()) {
+    if (TWCR & _BV(TWSTA)) {
+      TWSR = TW_START;
+      addressed = false;
+    } else if (!addressed) {
+      sent[sent_count].sla = TWDR;
+      sent[sent_count].length = 0;
+      sent_count++;
+      TWSR = TW_MT_SLA_ACK;
+      addressed = true;
+    } else {
+      transaction_t &t = sent[sent_count - 1];
+      t.bytes[t.length++] = TWDR;
+      TWSR = TW_MT_DATA_ACK;
+    }
+    TwiAsync::service();
+    // the STOP goes out at once
+    TWCR &= ~_BV(TWSTO);
+  }
+}
+
+// expander writes for one instruction or character, RS already set up
+static uint8_t expect(uint8_t *out, uint8_t value, uint8_t mode) {
+  uint8_t high = (value & 0xF0) | mode | bl;
+  uint8_t low = (value << 4) | mode | bl;
+  out[0] = high | en;
+  out[1] = high;
+  out[2] = low | en;
+  out[3] = low;
+  return 4;
+}
+
+static uint8_t expectSetup(uint8_t *out, uint8_t value, uint8_t mode) {
+  out[0] = (value & 0xF0) | mode | bl;
+  return 1 + expect(out + 1, value, mode);
+}
+
+void setUp() {
+  SREG = 0;
+  TwiAsync::begin();
+  TWCR = 0;
+  sent_count = 0;
+}
+
+void tearDown() {
+  drain();
+}
+
+void test_cursor_move_waits_for_the_characters() {
+  Hd44780I2c lcd(address, 20, 4);
+  lcd.setCursor(3, 1);
+  TEST_ASSERT_TRUE(TwiAsync::idle());
+  drain();
+  TEST_ASSERT_EQUAL_UINT8(0, sent_count);
+}
+
+void test_run_is_one_transaction() {
+  Hd44780I2c lcd(address, 20, 4);
+  lcd.setCursor(0, 1);
+  lcd.print("AB");
+  drain();
+
+  uint8_t bytes[16];
+  uint8_t length = expect(bytes, 0x80 | 0x40, 0);
+  length += expectSetup(bytes + length, 'A', rs);
+  length += expect(bytes + length, 'B', rs);
+  TEST_ASSERT_EQUAL_UINT8(1, sent_count);
+  TEST_ASSERT_EQUAL_HEX8(address << 1, sent[0].sla);
+  TEST_ASSERT_EQUAL_UINT8(length, sent[0].length);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(bytes, sent[0].bytes, length);
+}
+
+void test_rs_is_set_up_only_when_it_changes() {
+  Hd44780I2c lcd(address, 20, 4);
+  lcd.print("A");
+  lcd.print("C");
+  lcd.setCursor(5, 0);
+  lcd.print("D");
+  drain();
+
+  TEST_ASSERT_EQUAL_UINT8(3, sent_count);
+  TEST_ASSERT_EQUAL_UINT8(5, sent[0].length);
+  TEST_ASSERT_EQUAL_UINT8(4, sent[1].length);
+
+  uint8_t bytes[10];
+  uint8_t length = expectSetup(bytes, 0x80 | 5, 0);
+  length += expectSetup(bytes + length, 'D', rs);
+  TEST_ASSERT_EQUAL_UINT8(length, sent[2].length);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(bytes, sent[2].bytes, length);
+}
+
+void test_command_now_restores_rs() {
+  Hd44780I2c lcd(address, 20, 4);
+  lcd.print("A");
+  lcd.noDisplay();
+  lcd.print("B");
+  drain();
+
+  TEST_ASSERT_EQUAL_UINT8(3, sent_count);
+  TEST_ASSERT_EQUAL_UINT8(6, sent[1].length);
+  TEST_ASSERT_EQUAL_HEX8(0x00 | bl, sent[1].bytes[0]);
+  TEST_ASSERT_EQUAL_HEX8(0x80 | rs | bl, sent[1].bytes[5]);
+  // the run after it still finds RS set
+  TEST_ASSERT_EQUAL_UINT8(4, sent[2].length);
+}
+
+void test_room_counts_queued_bytes() {
+  Hd44780I2c lcd(address, 20, 4);
+  TEST_ASSERT_EQUAL_UINT8(20, lcd.room());
+  lcd.setCursor(0, 0);
+  lcd.print("AB");
+  TEST_ASSERT_EQUAL_UINT8(18, lcd.room());
+  lcd.setCursor(0, 1);
+  TEST_ASSERT_EQUAL_UINT8(17, lcd.room());
+  lcd.print("C");
+  drain();
+  TEST_ASSERT_EQUAL_UINT8(20, lcd.room());
+}
+
+void test_clear_holds_off_after_draining() {
+  Hd44780I2c lcd(address, 20, 4);
+  lcd.clear();
+  TEST_ASSERT_EQUAL_UINT8(0, lcd.room());
+  drain();
+  TEST_ASSERT_EQUAL_UINT8(0, lcd.room());
+  host_time_us += 1000;
+  TEST_ASSERT_EQUAL_UINT8(0, lcd.room());
+  host_time_us += 1000;
+  TEST_ASSERT_EQUAL_UINT8(20, lcd.room());
+}
+
+void test_frame_buffer_merges_short_gaps() {
+  Hd44780I2c lcd(address, 20, 4);
+  FrameBuffer frame;
+  frame.setCursor(0, 0);
+  frame.print("AB");
+  frame.setCursor(3, 0);
+  frame.print("D");
+  frame.setCursor(8, 0);
+  frame.print("X");
+  TEST_ASSERT_EQUAL_UINT8(5, frame.flush(lcd));
+  TEST_ASSERT_FALSE(frame.dirty());
+  drain();
+
+  // "AB D" in one run, the unchanged cell resent, then a cursor move to X
+  uint8_t bytes[40];
+  uint8_t length = expect(bytes, 0x80, 0);
+  length += expectSetup(bytes + length, 'A', rs);
+  length += expect(bytes + length, 'B', rs);
+  length += expect(bytes + length, ' ', rs);
+  length += expect(bytes + length, 'D', rs);
+  TEST_ASSERT_EQUAL_UINT8(2, sent_count);
+  TEST_ASSERT_EQUAL_UINT8(length, sent[0].length);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(bytes, sent[0].bytes, length);
+  TEST_ASSERT_EQUAL_UINT8(10, sent[1].length);
+
+  // nothing changed, nothing sent
+  TEST_ASSERT_EQUAL_UINT8(0, frame.flush(lcd));
+  drain();
+  TEST_ASSERT_EQUAL_UINT8(2, sent_count);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_cursor_move_waits_for_the_characters);
+  RUN_TEST(test_run_is_one_transaction);
+  RUN_TEST(test_rs_is_set_up_only_when_it_changes);
+  RUN_TEST(test_command_now_restores_rs);
+  RUN_TEST(test_room_counts_queued_bytes);
+  RUN_TEST(test_clear_holds_off_after_draining);
+  RUN_TEST(test_frame_buffer_merges_short_gaps);
+  return UNITY_END();
+}
@@ -0,0 +1,512 @@
+// Host tests for the Muses72323 driver, run with pio test -e native.
+// The driver writes into Muses72323MockTransport, the recorded frames are
+// checked directly or replayed into Muses72323Model for the chip state.
+
+#include <unity.h>
+#include <Muses72323.h>
+#include <Muses72323Group.h>
+#include <Muses72323Mock.h>
+#include <Muses72323Model.h>
+
+typedef Muses72323MockTransport<64> Mock;
+typedef Muses72323<Mock> Chip;
+
+static const uint16_t select_l = muses72323::s_control_attenuation_l;
+static const uint16_t select_r = muses72323::s_control_attenuation_r;
+static const uint16_t select_gain = muses72323::s_control_gain;
+static const uint16_t select_states = muses72323::s_control_states & 0b11100;
+
+static uint16_t selectOf(uint16_t frame) { return frame & 0b11100; }
+
+static bool linkBit(uint16_t frame) {
+  return frame & (1 << muses72323::s_state_bit_gain);
+}
+
+// feed every recorded frame to a model, one frame time apart
+static void replay(Muses72323Model &model) {
+  for (uint16_t i = 0; i < Mock::count; i++) {
+    model.receive(Mock::frames[i], (uint32_t)i * 35);
+  }
+}
+
+static int levelOf(Muses72323Model &model, Muses72323Model::channel_t channel) {
+  return model.levelAt(channel, (uint32_t)Mock::count * 35);
+}
+
+// frames from first on, all received at the mock's current time
+static void replayAt(Muses72323Model &model, uint16_t first) {
+  for (uint16_t i = first; i < Mock::count; i++) {
+    model.receive(Mock::frames[i], Mock::time);
+  }
+}
+
+// louder of the two channels after each frame from first on
+static int loudestDuring(Muses72323Model &model, uint16_t first) {
+  int loudest = Muses72323Model::level_muted;
+  for (uint16_t i = first; i < Mock::count; i++) {
+    model.receive(Mock::frames[i], (uint32_t)i * 35);
+    for (uint8_t ch = 0; ch < 2; ch++) {
+      int level = model.levelAt((Muses72323Model::channel_t)ch, (uint32_t)i * 35);
+      if (level > loudest) {
+        loudest = level;
+      }
+    }
+  }
+  return loudest;
+}
+
+// fired from inside Mock::send(), as the power fail interrupt would be
+static Chip *interrupted_chip;
+static uint16_t queued_by_interrupt;
+static void powerFail() {
+  interrupted_chip->urgentMute();
+  queued_by_interrupt = Mock::count;
+}
+
+void setUp() {
+  Mock::clear();
+  Mock::async = false;
+  Mock::time = 0;
+  Mock::interrupt = 0;
+}
+
+void tearDown() {}
+
+void test_repeated_writes_are_elided() {
+  Chip muses(0);
+  muses.begin();
+  muses.setVolume(-80, -80);
+  muses.setVolume(-80, -80);
+  TEST_ASSERT_EQUAL_UINT32(2, muses.getIssuedTransfers());
+  TEST_ASSERT_EQUAL_UINT32(2, muses.getElidedTransfers());
+  TEST_ASSERT_EQUAL_UINT16(2, Mock::count);
+
+  muses.setVolume(-80, -84);
+  TEST_ASSERT_EQUAL_UINT32(3, muses.getIssuedTransfers());
+  TEST_ASSERT_EQUAL_UINT32(3, muses.getElidedTransfers());
+  TEST_ASSERT_EQUAL_UINT16(select_r, selectOf(Mock::frames[2]));
+}
+
+void test_invalidate_sends_again() {
+  Chip muses(0);
+  muses.begin();
+  muses.setVolume(-80, -80);
+  muses.invalidate();
+  muses.setVolume(-80, -80);
+  TEST_ASSERT_EQUAL_UINT32(4, muses.getIssuedTransfers());
+  TEST_ASSERT_EQUAL_UINT32(0, muses.getElidedTransfers());
+  TEST_ASSERT_EQUAL_UINT16(Mock::frames[0], Mock::frames[2]);
+}
+
+void test_auto_link_sends_left_then_links() {
+  Chip muses(0);
+  muses.begin();
+  muses.setAutoLink(true);
+  muses.setVolume(-40, -40);
+  TEST_ASSERT_EQUAL_UINT16(2, Mock::count);
+  TEST_ASSERT_EQUAL_UINT16(select_l, selectOf(Mock::frames[0]));
+  TEST_ASSERT_EQUAL_UINT16(select_gain, selectOf(Mock::frames[1]));
+  TEST_ASSERT_TRUE(linkBit(Mock::frames[1]));
+
+  // still equal: one left word, the link is already on
+  muses.setVolume(-60, -60);
+  TEST_ASSERT_EQUAL_UINT16(3, Mock::count);
+  TEST_ASSERT_EQUAL_UINT16(select_l, selectOf(Mock::frames[2]));
+
+  Muses72323Model model(0);
+  replay(model);
+  TEST_ASSERT_TRUE(model.linked());
+  TEST_ASSERT_EQUAL_INT(-60, levelOf(model, Muses72323Model::left));
+  TEST_ASSERT_EQUAL_INT(-60, levelOf(model, Muses72323Model::right));
+}
+
+void test_auto_link_loads_right_before_unlinking() {
+  Chip muses(0);
+  muses.begin();
+  muses.setAutoLink(true);
+  muses.setVolume(-40, -40);
+  Mock::clear();
+
+  muses.setVolume(-48, -44);
+  TEST_ASSERT_EQUAL_UINT16(3, Mock::count);
+  TEST_ASSERT_EQUAL_UINT16(select_r, selectOf(Mock::frames[0]));
+  TEST_ASSERT_EQUAL_UINT16(select_gain, selectOf(Mock::frames[1]));
+  TEST_ASSERT_FALSE(linkBit(Mock::frames[1]));
+  TEST_ASSERT_EQUAL_UINT16(select_l, selectOf(Mock::frames[2]));
+
+  // left unchanged: the left word is elided after unlinking
+  muses.setVolume(-48, -52);
+  TEST_ASSERT_EQUAL_UINT16(4, Mock::count);
+  TEST_ASSERT_EQUAL_UINT16(select_r, selectOf(Mock::frames[3]));
+}
+
+void test_auto_link_unlinked_replay_levels() {
+  Chip muses(0);
+  muses.begin();
+  muses.setAutoLink(true);
+  muses.setVolume(-40, -40);
+  muses.setVolume(-48, -44);
+
+  Muses72323Model model(0);
+  replay(model);
+  TEST_ASSERT_FALSE(model.linked());
+  TEST_ASSERT_EQUAL_INT(-48, levelOf(model, Muses72323Model::left));
+  TEST_ASSERT_EQUAL_INT(-44, levelOf(model, Muses72323Model::right));
+}
+
+void test_urgent_mute_idle() {
+  Chip muses(0);
+  muses.begin();
+  muses.setVolume(-40, -44);
+  Mock::clear();
+
+  muses.urgentMute();
+  TEST_ASSERT_EQUAL_UINT16(4, Mock::count);
+  TEST_ASSERT_EQUAL_UINT16(select_states, selectOf(Mock::frames[0]));
+  TEST_ASSERT_EQUAL_UINT16(select_l, selectOf(Mock::frames[1]));
+  TEST_ASSERT_EQUAL_UINT16(select_r, selectOf(Mock::frames[2]));
+  TEST_ASSERT_EQUAL_UINT16(select_gain, selectOf(Mock::frames[3]));
+
+  // the mute holds until it is released
+  muses.setVolume(-40, -44);
+  TEST_ASSERT_EQUAL_UINT16(4, Mock::count);
+
+  // the shadow registers were invalidated, the next write goes out
+  muses.unmute();
+  muses.setVolume(-40, -44);
+  TEST_ASSERT_EQUAL_UINT16(6, Mock::count);
+}
+
+void test_urgent_mute_after_discarded_link_word() {
+  Chip muses(0);
+  muses.begin();
+  muses.setAutoLink(true);
+  muses.setAsync(true);
+  muses.setVolume(-40, -44);
+  Mock::latch();
+
+  // left goes out, the link word behind it is still queued when the mute
+  // fires and gets discarded: the chip stays unlinked, so right must be
+  // muted on its own
+  uint16_t shifting = Mock::count;
+  muses.setVolume(-20, -20);
+  TEST_ASSERT_EQUAL_UINT16(shifting + 2, Mock::count);
+  Mock::latched = shifting;
+  muses.urgentMute();
+  TEST_ASSERT_EQUAL_UINT16(shifting + 5, Mock::count);
+  Mock::latch();
+
+  Muses72323Model model(0);
+  replay(model);
+  TEST_ASSERT_EQUAL_INT(Muses72323Model::level_muted, levelOf(model, Muses72323Model::left));
+  TEST_ASSERT_EQUAL_INT(Muses72323Model::level_muted, levelOf(model, Muses72323Model::right));
+}
+
+void test_urgent_mute_mid_frame_blocking_is_deferred() {
+  Chip muses(0);
+  muses.begin();
+  muses.setVolume(-40, -40);
+  Mock::clear();
+
+  interrupted_chip = &muses;
+  Mock::interrupt = powerFail;
+  muses.setZeroCrossingOn(false);
+
+  // the frame being shifted out is finished first, then the mute follows
+  TEST_ASSERT_EQUAL_UINT16(5, Mock::count);
+  TEST_ASSERT_EQUAL_UINT16(select_gain, selectOf(Mock::frames[0]));
+  TEST_ASSERT_EQUAL_UINT16(select_states, selectOf(Mock::frames[1]));
+
+  Muses72323Model model(0);
+  replay(model);
+  TEST_ASSERT_EQUAL_INT(Muses72323Model::level_muted, levelOf(model, Muses72323Model::left));
+  TEST_ASSERT_EQUAL_INT(Muses72323Model::level_muted, levelOf(model, Muses72323Model::right));
+}
+
+void test_urgent_mute_mid_frame_async_is_queued_at_once() {
+  Chip muses(0);
+  muses.begin();
+  muses.setAsync(true);
+  muses.setVolume(-40, -40);
+  Mock::latch();
+  Mock::clear();
+
+  interrupted_chip = &muses;
+  Mock::interrupt = powerFail;
+  muses.setZeroCrossingOn(false);
+
+  // the mute is queued from the interrupt itself. the frame the main loop
+  // was pushing lands behind it and is discarded by the mute queued again
+  // after it, only the word already shifting out is kept
+  TEST_ASSERT_EQUAL_UINT16(4, queued_by_interrupt);
+  TEST_ASSERT_EQUAL_UINT16(5, Mock::count);
+  TEST_ASSERT_EQUAL_UINT16(select_states, selectOf(Mock::frames[0]));
+  TEST_ASSERT_EQUAL_UINT16(select_states, selectOf(Mock::frames[1]));
+  TEST_ASSERT_EQUAL_UINT16(select_gain, selectOf(Mock::frames[4]));
+
+  Muses72323Model model(0);
+  replay(model);
+  TEST_ASSERT_EQUAL_INT(Muses72323Model::level_muted, levelOf(model, Muses72323Model::left));
+  TEST_ASSERT_EQUAL_INT(Muses72323Model::level_muted, levelOf(model, Muses72323Model::right));
+}
+
+// the mute lands while the left frame of setVolume() is going out, the
+// right frame after it must not unmute the right channel
+static void muteDuringSetVolume(bool async) {
+  Chip muses(0);
+  muses.begin();
+  muses.setAsync(async);
+  muses.setVolume(-40, -44);
+  Mock::latch();
+
+  interrupted_chip = &muses;
+  Mock::interrupt = powerFail;
+  muses.setVolume(-20, -24);
+  Mock::latch();
+
+  Muses72323Model model(0);
+  replay(model);
+  TEST_ASSERT_EQUAL_INT(Muses72323Model::level_muted, levelOf(model, Muses72323Model::left));
+  TEST_ASSERT_EQUAL_INT(Muses72323Model::level_muted, levelOf(model, Muses72323Model::right));
+
+  // still muted after more setters, until unmute()
+  muses.setVolume(-20, -24);
+  muses.setLevel(8, 8);
+  Mock::latch();
+  Muses72323Model held(0);
+  replay(held);
+  TEST_ASSERT_EQUAL_INT(Muses72323Model::level_muted, levelOf(held, Muses72323Model::left));
+  TEST_ASSERT_EQUAL_INT(Muses72323Model::level_muted, levelOf(held, Muses72323Model::right));
+
+  muses.unmute();
+  muses.setLevel(-20, -24);
+  Mock::latch();
+  Muses72323Model released(0);
+  replay(released);
+  TEST_ASSERT_EQUAL_INT(-20, levelOf(released, Muses72323Model::left));
+  TEST_ASSERT_EQUAL_INT(-24, levelOf(released, Muses72323Model::right));
+}
+
+void test_urgent_mute_between_set_volume_frames_blocking() {
+  muteDuringSetVolume(false);
+}
+
+void test_urgent_mute_between_set_volume_frames_async() {
+  muteDuringSetVolume(true);
+}
+
+void test_urgent_mute_cancels_commit() {
+  Chip muses(0);
+  muses.begin();
+  muses.setVolume(-40, -44);
+  Mock::clear();
+
+  muses.beginCommit();
+  muses.setVolume(-20, -24);
+  muses.urgentMute();
+  uint16_t muted = Mock::count;
+  muses.commit();
+  TEST_ASSERT_EQUAL_UINT16(muted, Mock::count);
+}
+
+void test_set_level_attenuates_before_raising_gain() {
+  Chip muses(0);
+  muses.begin();
+  muses.setLevel(-40, -44);
+  Mock::clear();
+
+  muses.setLevel(40, 36);
+  TEST_ASSERT_EQUAL_UINT16(3, Mock::count);
+  TEST_ASSERT_EQUAL_UINT16(select_l, selectOf(Mock::frames[0]));
+  TEST_ASSERT_EQUAL_UINT16(select_r, selectOf(Mock::frames[1]));
+  TEST_ASSERT_EQUAL_UINT16(select_gain, selectOf(Mock::frames[2]));
+}
+
+void test_set_level_drops_gain_before_attenuation() {
+  Chip muses(0);
+  muses.begin();
+  muses.setLevel(40, 36);
+  Mock::clear();
+
+  muses.setLevel(-40, -44);
+  TEST_ASSERT_EQUAL_UINT16(3, Mock::count);
+  TEST_ASSERT_EQUAL_UINT16(select_gain, selectOf(Mock::frames[0]));
+  TEST_ASSERT_EQUAL_UINT16(select_l, selectOf(Mock::frames[1]));
+  TEST_ASSERT_EQUAL_UINT16(select_r, selectOf(Mock::frames[2]));
+}
+
+void test_set_level_never_overshoots() {
+  Chip muses(0);
+  muses.begin();
+  muses.setAutoLink(true);
+  Muses72323Model model(0);
+
+  // up and down across the gain steps, with and without balance
+  static const int16_t steps[][2] = {
+    {-80, -80}, {8, 8}, {40, 36}, {120, 120}, {-4, -12}, {60, 60}, {-100, -96}
+  };
+  int16_t before = Muses72323Model::level_muted;
+  for (uint8_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+    uint16_t first = Mock::count;
+    muses.setLevel(steps[i][0], steps[i][1]);
+    int16_t after = steps[i][0] > steps[i][1] ? steps[i][0] : steps[i][1];
+    int loudest = loudestDuring(model, first);
+    int limit = before > after ? before : after;
+    TEST_ASSERT_LESS_OR_EQUAL(limit, loudest);
+    TEST_ASSERT_EQUAL_INT(steps[i][0], model.levelAt(Muses72323Model::left, (uint32_t)Mock::count * 35));
+    TEST_ASSERT_EQUAL_INT(steps[i][1], model.levelAt(Muses72323Model::right, (uint32_t)Mock::count * 35));
+    before = after;
+  }
+}
+
+void test_settle_time_follows_soft_step() {
+  Chip muses(0);
+  muses.begin();
+  muses.setVolume(-40, -40);
+  TEST_ASSERT_EQUAL_UINT32(0, muses.getSettleTime());
+
+  muses.setSoftStep(true, 1);
+  Muses72323Model model(0);
+  replayAt(model, 0);
+
+  // 20 steps on the left, 4 on the right: the later one settles
+  Mock::time = 100000;
+  uint16_t first = Mock::count;
+  muses.setVolume(-60, -44);
+  uint32_t period = muses72323::s_soft_step_base_us << 1;
+  TEST_ASSERT_EQUAL_UINT32(period, muses.getSoftStepPeriod());
+  TEST_ASSERT_EQUAL_UINT32(20 * period, muses.getSettleTime());
+  TEST_ASSERT_FALSE(muses.settled());
+
+  replayAt(model, first);
+  TEST_ASSERT_EQUAL_UINT32(Mock::time + 20 * period, model.settledAt(Muses72323Model::left));
+  TEST_ASSERT_EQUAL_UINT32(Mock::time + 4 * period, model.settledAt(Muses72323Model::right));
+
+  Mock::time += 10 * period;
+  TEST_ASSERT_EQUAL_UINT32(10 * period, muses.getSettleTime());
+  TEST_ASSERT_EQUAL_INT(-50, model.levelAt(Muses72323Model::left, Mock::time));
+  Mock::time += 10 * period;
+  TEST_ASSERT_TRUE(muses.settled());
+  TEST_ASSERT_EQUAL_INT(-60, model.levelAt(Muses72323Model::left, Mock::time));
+}
+
+void test_unmute_restores_soft_step() {
+  Chip muses(0);
+  muses.begin();
+  muses.setSoftStep(true, 1);
+  muses.urgentMute();
+  TEST_ASSERT_EQUAL_UINT16(0, muses.getSoftStepPeriod());
+
+  // changed while held: applied on unmute()
+  muses.setSoftStep(true, 2);
+  TEST_ASSERT_EQUAL_UINT16(0, muses.getSoftStepPeriod());
+  Mock::clear();
+  muses.unmute();
+  TEST_ASSERT_EQUAL_UINT16(muses72323::s_soft_step_base_us << 2, muses.getSoftStepPeriod());
+  TEST_ASSERT_EQUAL_UINT16(select_states, selectOf(Mock::frames[0]));
+  TEST_ASSERT_TRUE(Mock::frames[0] & (1 << muses72323::s_state_soft_step));
+}
+
+void test_unmute_leaves_soft_step_off_when_it_was() {
+  Chip muses(0);
+  muses.begin();
+  muses.urgentMute();
+  muses.unmute();
+  TEST_ASSERT_EQUAL_UINT16(0, muses.getSoftStepPeriod());
+}
+
+void test_scrub_round_robin() {
+  Chip muses(0);
+  muses.begin();
+  muses.setScrubInterval(250);
+  TEST_ASSERT_FALSE(muses.scrub());
+
+  muses.setVolume(-40, -44);
+  Mock::clear();
+  TEST_ASSERT_FALSE(muses.scrub());
+
+  Mock::time += 250000;
+  TEST_ASSERT_TRUE(muses.scrub());
+  TEST_ASSERT_FALSE(muses.scrub());
+  Mock::time += 250000;
+  TEST_ASSERT_TRUE(muses.scrub());
+  Mock::time += 250000;
+  TEST_ASSERT_TRUE(muses.scrub());
+
+  // only the two shadowed registers, in turn
+  TEST_ASSERT_EQUAL_UINT16(3, Mock::count);
+  TEST_ASSERT_EQUAL_UINT16(select_l, selectOf(Mock::frames[0]));
+  TEST_ASSERT_EQUAL_UINT16(select_r, selectOf(Mock::frames[1]));
+  TEST_ASSERT_EQUAL_UINT16(select_l, selectOf(Mock::frames[2]));
+  TEST_ASSERT_EQUAL_UINT32(3, muses.getScrubWrites());
+  TEST_ASSERT_EQUAL_UINT32(2, muses.getIssuedTransfers());
+}
+
+void test_scrub_disabled() {
+  Chip muses(0);
+  muses.begin();
+  muses.setVolume(-40, -44);
+  Mock::time += 1000000;
+  TEST_ASSERT_FALSE(muses.scrub());
+  TEST_ASSERT_EQUAL_UINT32(0, muses.getScrubWrites());
+}
+
+void test_group_burst() {
+  Chip front(0);
+  Chip rear(1);
+  Muses72323Group<Mock, 2> group;
+  TEST_ASSERT_TRUE(group.add(front));
+  TEST_ASSERT_TRUE(group.add(rear, -8));
+  group.begin();
+  front.begin();
+  rear.begin();
+
+  group.setLevel(-40, -40);
+  TEST_ASSERT_EQUAL_UINT16(1, Mock::bursts);
+  TEST_ASSERT_EQUAL_UINT8(Mock::count, group.getLastWords());
+  TEST_ASSERT_EQUAL_UINT16(0, Mock::frames[0] & 0b11);
+  TEST_ASSERT_EQUAL_UINT16(1, Mock::frames[Mock::count - 1] & 0b11);
+
+  Muses72323Model front_model(0);
+  Muses72323Model rear_model(1);
+  replay(front_model);
+  replay(rear_model);
+  TEST_ASSERT_EQUAL_INT(-40, levelOf(front_model, Muses72323Model::left));
+  TEST_ASSERT_EQUAL_INT(-48, levelOf(rear_model, Muses72323Model::right));
+
+  // nothing changed: a burst with no words
+  uint16_t sent = Mock::count;
+  group.setLevel(-40, -40);
+  TEST_ASSERT_EQUAL_UINT16(2, Mock::bursts);
+  TEST_ASSERT_EQUAL_UINT8(0, group.getLastWords());
+  TEST_ASSERT_EQUAL_UINT16(sent, Mock::count);
+
+  group.mute();
+  TEST_ASSERT_EQUAL_UINT8(4, group.getLastWords());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_repeated_writes_are_elided);
+  RUN_TEST(test_invalidate_sends_again);
+  RUN_TEST(test_auto_link_sends_left_then_links);
+  RUN_TEST(test_auto_link_loads_right_before_unlinking);
+  RUN_TEST(test_auto_link_unlinked_replay_levels);
+  RUN_TEST(test_urgent_mute_idle);
+  RUN_TEST(test_urgent_mute_after_discarded_link_word);
+  RUN_TEST(test_urgent_mute_mid_frame_blocking_is_deferred);
+  RUN_TEST(test_urgent_mute_mid_frame_async_is_queued_at_once);
+  RUN_TEST(test_urgent_mute_between_set_volume_frames_blocking);
+  RUN_TEST(test_urgent_mute_between_set_volume_frames_async);
+  RUN_TEST(test_urgent_mute_cancels_commit);
+  RUN_TEST(test_set_level_attenuates_before_raising_gain);
+  RUN_TEST(test_set_level_drops_gain_before_attenuation);
+  RUN_TEST(test_set_level_never_overshoots);
+  RUN_TEST(test_settle_time_follows_soft_step);
+  RUN_TEST(test_unmute_restores_soft_step);
+  RUN_TEST(test_unmute_leaves_soft_step_off_when_it_was);
+  RUN_TEST(test_scrub_round_robin);
+  RUN_TEST(test_scrub_disabled);
+  RUN_TEST(test_group_burst);
+  return UNITY_END();
+}
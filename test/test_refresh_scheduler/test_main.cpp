@@ -0,0 +1,64 @@
+// Host tests for RefreshScheduler, run with pio test -e native. millis()
+// follows host_time_us.
+
+#include <unity.h>
+#include <Arduino.h>
+#include <RefreshScheduler.h>
+
+void setUp() {
+  host_time_us = 1000000;
+}
+
+void tearDown() {}
+
+void test_nothing_due_without_invalidate() {
+  RefreshScheduler refresh(30);
+  TEST_ASSERT_FALSE(refresh.due());
+  host_time_us += 100000;
+  TEST_ASSERT_FALSE(refresh.due());
+}
+
+void test_changes_merge_into_one_frame() {
+  RefreshScheduler refresh(30);
+  refresh.invalidate();
+  refresh.invalidate();
+  TEST_ASSERT_TRUE(refresh.due());
+  TEST_ASSERT_FALSE(refresh.isPending());
+  host_time_us += 100000;
+  TEST_ASSERT_FALSE(refresh.due());
+}
+
+void test_rate_is_limited() {
+  RefreshScheduler refresh(30);
+  refresh.invalidate();
+  TEST_ASSERT_TRUE(refresh.due());
+
+  // 1000 / 30 = 33ms between frames, the change waits for the slot
+  refresh.invalidate();
+  host_time_us += 32000;
+  TEST_ASSERT_FALSE(refresh.due());
+  TEST_ASSERT_TRUE(refresh.isPending());
+  host_time_us += 1000;
+  TEST_ASSERT_TRUE(refresh.due());
+}
+
+void test_millis_wrapping_16_bits() {
+  RefreshScheduler refresh(30);
+  host_time_us = 65530000UL;
+  refresh.invalidate();
+  TEST_ASSERT_TRUE(refresh.due());
+  refresh.invalidate();
+  host_time_us += 20000;
+  TEST_ASSERT_FALSE(refresh.due());
+  host_time_us += 20000;
+  TEST_ASSERT_TRUE(refresh.due());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_nothing_due_without_invalidate);
+  RUN_TEST(test_changes_merge_into_one_frame);
+  RUN_TEST(test_rate_is_limited);
+  RUN_TEST(test_millis_wrapping_16_bits);
+  return UNITY_END();
+}
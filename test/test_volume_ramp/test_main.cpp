@@ -0,0 +1,152 @@
+// Host tests for VolumeRamp, run with pio test -e native. tick() is called
+// directly, standing in for the timer interrupt.
+
+#include <unity.h>
+#include <Arduino.h>
+#include <VolumeRamp.h>
+
+static const uint16_t tick_rate = 1000;
+
+// tick until idle or limit ticks, returns the ticks taken. steps counts the
+// ticks that reported a change, lowest the lowest level passed through
+static uint16_t run(VolumeRamp &ramp, uint16_t limit, uint16_t &steps, int &lowest) {
+  uint16_t ticks = 0;
+  steps = 0;
+  lowest = ramp.current();
+  while (!ramp.idle() && ticks < limit) {
+    if (ramp.tick()) {
+      steps++;
+    }
+    if (ramp.current() < lowest) {
+      lowest = ramp.current();
+    }
+    ticks++;
+  }
+  return ticks;
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_reaches_the_exact_target() {
+  VolumeRamp ramp(tick_rate, 0);
+  ramp.setSlewRate(250);
+  ramp.setTarget(-40);
+  uint16_t steps;
+  int lowest;
+  uint16_t ticks = run(ramp, 10000, steps, lowest);
+  TEST_ASSERT_EQUAL_INT(-40, ramp.current());
+  TEST_ASSERT_EQUAL_UINT16(40, steps);
+  TEST_ASSERT_EQUAL_UINT16(160, ticks);
+  TEST_ASSERT_EQUAL_INT(-40, lowest);
+  TEST_ASSERT_FALSE(ramp.tick());
+}
+
+void test_rate_that_does_not_divide_the_tick_rate() {
+  // 300 steps per second at 1 kHz: 3 steps every 10 ticks, no drift
+  VolumeRamp ramp(tick_rate, -447);
+  ramp.setSlewRate(300);
+  ramp.setTarget(0);
+  uint16_t steps = 0;
+  for (uint16_t i = 0; i < 1000; i++) {
+    if (ramp.tick()) {
+      steps++;
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT16(300, steps);
+  TEST_ASSERT_EQUAL_INT(-147, ramp.current());
+
+  int lowest;
+  run(ramp, 10000, steps, lowest);
+  TEST_ASSERT_EQUAL_INT(0, ramp.current());
+  TEST_ASSERT_EQUAL_UINT16(147, steps);
+}
+
+void test_slew_rate_is_capped_at_one_step_per_tick() {
+  VolumeRamp ramp(tick_rate, 0);
+  ramp.setSlewRate(5000);
+  ramp.setTarget(-10);
+  for (uint8_t i = 0; i < 10; i++) {
+    TEST_ASSERT_TRUE(ramp.tick());
+  }
+  TEST_ASSERT_EQUAL_INT(-10, ramp.current());
+  TEST_ASSERT_TRUE(ramp.idle());
+}
+
+void test_retarget_mid_ramp_turns_around() {
+  VolumeRamp ramp(tick_rate, 0);
+  ramp.setSlewRate(250);
+  ramp.setTarget(-40);
+  for (uint8_t i = 0; i < 40; i++) {
+    ramp.tick();
+  }
+  TEST_ASSERT_EQUAL_INT(-10, ramp.current());
+
+  // from where the output is now, not from the old target
+  ramp.setTarget(8);
+  TEST_ASSERT_EQUAL_INT(8, ramp.target());
+  uint16_t steps;
+  int lowest;
+  uint16_t ticks = run(ramp, 10000, steps, lowest);
+  TEST_ASSERT_EQUAL_INT(8, ramp.current());
+  TEST_ASSERT_EQUAL_UINT16(18, steps);
+  TEST_ASSERT_EQUAL_UINT16(72, ticks);
+  TEST_ASSERT_EQUAL_INT(-10, lowest);
+}
+
+void test_jump_is_reported_once() {
+  VolumeRamp ramp(tick_rate, -40);
+  ramp.setSlewRate(250);
+  ramp.setTarget(0);
+  ramp.tick();
+
+  // cancels the ramp, reported even when it lands on the same level
+  ramp.jumpTo(-40);
+  TEST_ASSERT_FALSE(ramp.idle());
+  TEST_ASSERT_EQUAL_INT(-40, ramp.target());
+  TEST_ASSERT_TRUE(ramp.tick());
+  TEST_ASSERT_EQUAL_INT(-40, ramp.current());
+  TEST_ASSERT_FALSE(ramp.tick());
+  TEST_ASSERT_TRUE(ramp.idle());
+}
+
+void test_jump_restarts_the_step_fraction() {
+  VolumeRamp ramp(tick_rate, 0);
+  ramp.setSlewRate(250);
+  ramp.setTarget(-40);
+  ramp.tick();
+  ramp.tick();
+  ramp.tick();
+
+  // a fresh ramp after the jump takes the full four ticks per step
+  ramp.jumpTo(-100);
+  ramp.tick();
+  ramp.setTarget(-101);
+  TEST_ASSERT_FALSE(ramp.tick());
+  TEST_ASSERT_FALSE(ramp.tick());
+  TEST_ASSERT_FALSE(ramp.tick());
+  TEST_ASSERT_TRUE(ramp.tick());
+  TEST_ASSERT_EQUAL_INT(-101, ramp.current());
+}
+
+void test_refresh_forces_one_report() {
+  VolumeRamp ramp(tick_rate, -40);
+  TEST_ASSERT_TRUE(ramp.idle());
+  TEST_ASSERT_FALSE(ramp.tick());
+  ramp.refresh();
+  TEST_ASSERT_FALSE(ramp.idle());
+  TEST_ASSERT_TRUE(ramp.tick());
+  TEST_ASSERT_FALSE(ramp.tick());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_reaches_the_exact_target);
+  RUN_TEST(test_rate_that_does_not_divide_the_tick_rate);
+  RUN_TEST(test_slew_rate_is_capped_at_one_step_per_tick);
+  RUN_TEST(test_retarget_mid_ramp_turns_around);
+  RUN_TEST(test_jump_is_reported_once);
+  RUN_TEST(test_jump_restarts_the_step_fraction);
+  RUN_TEST(test_refresh_forces_one_report);
+  return UNITY_END();
+}
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""Generate the Muses72323 level tables.
+
+Writes lib/Muses72323/Muses72323Levels.{h,cpp}. Run again after changing
+the settings below and commit the output.
+
+Level planner: a signed level in 0.25 dB steps from -111.75 dB to +31.5 dB
+is split into a gain code (0.5 dB steps, 0..+31.5 dB) and an attenuation
+word. The split keeps the gain at 0 dB up to 0 dB and at +31.5 dB above
+it, so the gain register only changes when the level crosses 0 dB and
+every other step is a single attenuation write.
+
+Each entry holds ready-to-send attenuation words for both channels with
+the per-channel trim below already applied, so a volume step is one
+indexed read from flash. Display text comes from formatQuarterDb()
+(lib/DecibelText) rather than a table.
+"""
+
+import os
+
+LEVEL_MIN = -447   # -111.75 dB
+LEVEL_MAX = 126    # +31.5 dB
+GAIN_MAX = 63      # +31.5 dB in 0.5 dB steps
+GAIN_SHIFT = 9     # gain code sits at D14..D9 of the gain register
+
+# per-channel calibration in 0.25 dB steps, added to every level
+TRIM_L = 0
+TRIM_R = 0
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+OUT = os.path.join(ROOT, "lib", "Muses72323")
+
+
+def attenuation_word(level):
+    # 0.0 dB -> 0b000100000, -111.75 dB -> 0b111011111, at D15..D7
+    # trimmed levels are clamped to the attenuator range
+    level = max(-447, min(0, level))
+    return (32 - level) << 7
+
+
+def plan(level):
+    gain = 0 if level <= 0 else GAIN_MAX
+    attenuation = level - 2 * gain
+    return (attenuation_word(attenuation + TRIM_L),
+            attenuation_word(attenuation + TRIM_R), gain)
+
+
+def main():
+    rows = []
+    for level in range(LEVEL_MIN, LEVEL_MAX + 1):
+        attenuation_l, attenuation_r, gain = plan(level)
+        # gain is stored as the high byte of its register data
+        rows.append("  { 0x%04X, 0x%04X, 0x%02X }, // %+7.2f dB" %
+                    (attenuation_l, attenuation_r, (gain << GAIN_SHIFT) >> 8, level / 4))
+
+    with open(os.path.join(OUT, "Muses72323Levels.h"), "w") as f:
+        f.write("""// generated by tools/gen_muses_tables.py, do not edit
+
+#ifndef INCLUDED_MUSES_72323_LEVELS
+#define INCLUDED_MUSES_72323_LEVELS
+
+#include <stdint.h>
+
+namespace muses72323 {
+  static const int s_level_min = %d;
+  static const int s_level_max = %d;
+
+  // per-channel trim baked into the table, 0.25 dB steps
+  static const int s_trim_l = %d;
+  static const int s_trim_r = %d;
+
+  // one entry per 0.25 dB level, read from flash with pgm_read_*
+  struct level_plan_t {
+    uint16_t attenuation_l;  // attenuation register data, trim applied
+    uint16_t attenuation_r;
+    uint8_t gain;            // high byte of the gain register data
+  };
+
+  extern const level_plan_t s_level_plan[s_level_max - s_level_min + 1];
+}
+
+#endif // INCLUDED_MUSES_72323_LEVELS
+""" % (LEVEL_MIN, LEVEL_MAX, TRIM_L, TRIM_R))
+
+    with open(os.path.join(OUT, "Muses72323Levels.cpp"), "w") as f:
+        f.write("""// generated by tools/gen_muses_tables.py, do not edit
+
+#include "Muses72323Levels.h"
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#endif
+
+namespace muses72323 {
+const level_plan_t s_level_plan[] PROGMEM = {
+%s
+};
+}
+""" % "\n".join(rows))
+
+
+if __name__ == "__main__":
+    main()
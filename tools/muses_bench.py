@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Run the Muses72323 write path benchmark under simavr.
+
+Builds every bench_* environment in platformio.ini, runs each firmware in
+simavr as an ATmega328P at 16 MHz and collects the lines printed by
+bench/muses_bench.cpp and bench/display_bench.cpp (the bench_lcd_*
+environments). The results are written as tab separated values,
+one row per configuration and API call:
+
+    env  config  call  calls  cycles  max_cycles  us  idle_cycles  idle_us
+
+cycles is the mean time until the call returned, idle_cycles the mean time
+until the transport had sent everything (for the display, until the
+controller took the next instruction). With --baseline the results are
+compared with an earlier file and the script fails if any call got slower
+by more than --threshold percent.
+
+simavr models the SPI peripheral but not the USART in SPI mode, the usart
+numbers use its asynchronous timing at the same baud register.
+
+Nothing answers on simavr's I2C bus, so the bench_lcd_i2c* environments run
+in tools/simavr_twi_peer.c instead, built here against libsimavr, which
+acknowledges the LCD backpack address. A row whose I2C transactions were
+still dropped (errors > 0) timed aborted transfers and fails the run.
+
+usage: muses_bench.py [--output bench_output.txt] [--baseline FILE]
+                      [--threshold 5] [--no-build] [--env bench_hw ...]
+"""
+
+import argparse
+import configparser
+import os
+import re
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+F_CPU = 16000000
+LINE = re.compile(r"bench (\S+) (\S+) (\d+) (\d+) (\d+) (\d+)(?: (\d+))?")
+FIELDS = ["env", "config", "call", "calls", "cycles", "max_cycles", "us",
+          "idle_cycles", "idle_us", "errors"]
+PEER_SOURCE = os.path.join(ROOT, "tools", "simavr_twi_peer.c")
+PEER = os.path.join(ROOT, ".pio", "simavr_twi_peer")
+
+
+def build_peer():
+    """Build the simavr runner with an I2C peer, once."""
+    if os.path.exists(PEER) and \
+            os.path.getmtime(PEER) >= os.path.getmtime(PEER_SOURCE):
+        return PEER
+    try:
+        flags = subprocess.run(["pkg-config", "--cflags", "--libs", "simavr"],
+                               stdout=subprocess.PIPE, check=True)
+        flags = flags.stdout.decode().split()
+    except (OSError, subprocess.CalledProcessError):
+        flags = ["-lsimavr"]
+    os.makedirs(os.path.dirname(PEER), exist_ok=True)
+    subprocess.run(["cc", "-O2", "-o", PEER, PEER_SOURCE] + flags + ["-lelf"],
+                   check=True)
+    return PEER
+
+
+def bench_envs():
+    config = configparser.ConfigParser(inline_comment_prefixes=";")
+    config.read(os.path.join(ROOT, "platformio.ini"))
+    return [section[4:] for section in config.sections()
+            if section.startswith("env:bench_")]
+
+
+def run(env, build, timeout):
+    if build:
+        subprocess.run(["pio", "run", "-e", env], cwd=ROOT, check=True,
+                       stdout=subprocess.DEVNULL)
+    elf = os.path.join(ROOT, ".pio", "build", env, "firmware.elf")
+    # simavr quits once the firmware sleeps with interrupts disabled
+    if env.startswith("bench_lcd_i2c"):
+        command = [build_peer(), elf]
+    else:
+        command = ["simavr", "-m", "atmega328p", "-f", str(F_CPU), elf]
+    out = subprocess.run(command,
+                         stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                         timeout=timeout, check=False).stdout.decode(errors="replace")
+    if "bench end" not in out:
+        raise RuntimeError("%s: no complete benchmark output\n%s" % (env, out))
+    rows = []
+    for config, call, calls, cycles, worst, idle, errors in LINE.findall(out):
+        rows.append({
+            "env": env, "config": config, "call": call, "calls": calls,
+            "cycles": cycles, "max_cycles": worst,
+            "us": "%.2f" % (int(cycles) * 1e6 / F_CPU),
+            "idle_cycles": idle,
+            "idle_us": "%.2f" % (int(idle) * 1e6 / F_CPU),
+            "errors": errors or "0",
+        })
+    return rows
+
+
+def write(path, rows):
+    with open(path, "w") as out:
+        out.write("\t".join(FIELDS) + "\n")
+        for row in rows:
+            out.write("\t".join(row.get(field, "0") for field in FIELDS) + "\n")
+
+
+def read(path):
+    with open(path) as src:
+        header = src.readline().rstrip("\n").split("\t")
+        return [dict(zip(header, line.rstrip("\n").split("\t"))) for line in src]
+
+
+def compare(rows, baseline, threshold):
+    before = {(row["env"], row["call"]): row for row in baseline}
+    slower = 0
+    for row in rows:
+        old = before.get((row["env"], row["call"]))
+        if old is None:
+            continue
+        for field in ("cycles", "idle_cycles"):
+            a, b = int(old[field]), int(row[field])
+            change = 100.0 * (b - a) / a if a else 0.0
+            if change > threshold:
+                slower += 1
+                print("slower: %s %s %s %d -> %d (%+.1f%%)" % (
+                    row["env"], row["call"], field, a, b, change))
+    return slower
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--output", default=os.path.join(ROOT, "bench_output.txt"))
+    parser.add_argument("--baseline")
+    parser.add_argument("--threshold", type=float, default=5.0)
+    parser.add_argument("--no-build", dest="build", action="store_false")
+    parser.add_argument("--timeout", type=float, default=60.0)
+    parser.add_argument("--env", action="append")
+    args = parser.parse_args()
+
+    rows = []
+    for env in args.env or bench_envs():
+        rows += run(env, args.build, args.timeout)
+    write(args.output, rows)
+
+    failed = False
+    for row in rows:
+        print("%-22s %-18s %8s cycles %9s us   idle %8s cycles%s" % (
+            row["config"], row["call"], row["cycles"], row["us"], row["idle_cycles"],
+            "   %s I2C errors" % row["errors"] if row["errors"] != "0" else ""))
+        failed = failed or row["errors"] != "0"
+    if failed:
+        print("I2C transactions were dropped, those timings are not valid")
+
+    if args.baseline and compare(rows, read(args.baseline), args.threshold):
+        failed = True
+    if failed:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
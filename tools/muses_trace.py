@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+"""Decode the binary Muses72323 register trace.
+
+Firmware built with -D MUSES72323_TRACE writes one 10 byte frame per
+register write to the serial port (see Muses72323::traceDrain):
+
+    0xA5, dropped, time[4], address[2], data[2]    (little endian)
+
+Each record is printed in the bit-string format the driver used to dump
+over Serial: chip address, control address, data and the resulting
+command word, followed by the timestamp.
+
+usage: muses_trace.py [FILE | SERIAL_PORT] [--baud 115200]
+       reads stdin when no source is given
+"""
+
+import argparse
+import struct
+import sys
+
+SYNC = 0xA5
+FRAME = struct.Struct("<BBIHH")
+
+
+def bits(value):
+    # matches the old firmware dump: bits 15..7, a space, bits 6..0
+    text = format(value & 0xFFFF, "016b")
+    return text[:9] + " " + text[9:]
+
+
+def frames(stream):
+    buf = b""
+    while True:
+        chunk = stream.read(FRAME.size)
+        if not chunk:
+            return
+        buf += chunk
+        while len(buf) >= FRAME.size:
+            if buf[0] != SYNC:
+                buf = buf[1:]
+                continue
+            yield FRAME.unpack(buf[:FRAME.size])[1:]
+            buf = buf[FRAME.size:]
+
+
+def open_source(path, baud):
+    if path is None:
+        return sys.stdin.buffer
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial  # pyserial
+        return serial.Serial(path, baud)
+    return open(path, "rb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("source", nargs="?")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    last = None
+    for dropped, time, address, data in frames(open_source(args.source, args.baud)):
+        if dropped:
+            print("# %d record(s) dropped" % dropped)
+        chip = address & 0b11
+        delta = "" if last is None else "+%d" % ((time - last) & 0xFFFFFFFF)
+        last = time
+        print("%s\t%s\t%s\t%s\t%10u us %s" % (
+            bits(chip), bits(address & ~0b11), bits(data),
+            bits(address | data), time, delta))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,111 @@
+/* simavr runner with an I2C peer
+*********************************
+
+Runs a firmware like the simavr command line does (ATmega328P, 16 MHz,
+UART0 on stdout) with a device on the TWI bus that acknowledges its
+address and every byte written to it, so I2C writes complete as they would
+with a PCF8574 attached. What is written is not checked. Used by
+tools/muses_bench.py for the lcd_i2c benchmark environments.
+
+Build against libsimavr:
+	cc -O2 -o simavr_twi_peer tools/simavr_twi_peer.c \
+		$(pkg-config --cflags --libs simavr) -lelf
+
+usage: simavr_twi_peer [-a address] firmware.elf
+	address is the 7-bit address to acknowledge, 0x27 by default
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_irq.h>
+#include <simavr/avr_twi.h>
+
+typedef struct peer_t {
+	avr_irq_t *irq;   // TWI_IRQ_INPUT and TWI_IRQ_OUTPUT, as seen by the peer
+	uint8_t address;  // 7-bit
+	uint8_t selected; // addressed since the last START
+} peer_t;
+
+// bus events from the TWI peripheral
+static void peer_hook(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+	peer_t *peer = (peer_t *)param;
+	avr_twi_msg_irq_t msg;
+	msg.u.v = value;
+
+	if (msg.u.twi.msg & TWI_COND_STOP) {
+		peer->selected = 0;
+	}
+	if (msg.u.twi.msg & TWI_COND_START) {
+		peer->selected = (msg.u.twi.addr >> 1) == peer->address;
+		if (peer->selected) {
+			avr_raise_irq(peer->irq + TWI_IRQ_INPUT,
+				avr_twi_irq_msg(TWI_COND_ACK, msg.u.twi.addr, 1));
+		}
+	}
+	if (peer->selected && (msg.u.twi.msg & TWI_COND_WRITE)) {
+		avr_raise_irq(peer->irq + TWI_IRQ_INPUT,
+			avr_twi_irq_msg(TWI_COND_ACK, msg.u.twi.addr, 1));
+	}
+}
+
+static const char *peer_irq_names[2] = {
+	[TWI_IRQ_INPUT] = "8>twi_peer.out",
+	[TWI_IRQ_OUTPUT] = "32<twi_peer.in",
+};
+
+static void peer_attach(avr_t *avr, peer_t *peer)
+{
+	peer->irq = avr_alloc_irq(&avr->irq_pool, 0, 2, peer_irq_names);
+	avr_irq_register_notify(peer->irq + TWI_IRQ_OUTPUT, peer_hook, peer);
+	avr_connect_irq(peer->irq + TWI_IRQ_INPUT,
+		avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_INPUT));
+	avr_connect_irq(avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_OUTPUT),
+		peer->irq + TWI_IRQ_OUTPUT);
+}
+
+int main(int argc, char *argv[])
+{
+	peer_t peer = {0};
+	peer.address = 0x27;
+
+	int arg = 1;
+	if (argc > 3 && !strcmp(argv[1], "-a")) {
+		peer.address = (uint8_t)strtol(argv[2], NULL, 0);
+		arg = 3;
+	}
+	if (arg != argc - 1) {
+		fprintf(stderr, "usage: %s [-a address] firmware.elf\n", argv[0]);
+		return 2;
+	}
+
+	elf_firmware_t firmware;
+	memset(&firmware, 0, sizeof(firmware));
+	if (elf_read_firmware(argv[arg], &firmware)) {
+		fprintf(stderr, "%s: cannot read %s\n", argv[0], argv[arg]);
+		return 1;
+	}
+
+	avr_t *avr = avr_make_mcu_by_name("atmega328p");
+	if (!avr) {
+		fprintf(stderr, "%s: no atmega328p core\n", argv[0]);
+		return 1;
+	}
+	avr_init(avr);
+	firmware.frequency = 16000000;
+	avr_load_firmware(avr, &firmware);
+	avr->frequency = firmware.frequency;
+	peer_attach(avr, &peer);
+
+	// the benchmarks end by sleeping with interrupts off, simavr then stops
+	int state;
+	do {
+		state = avr_run(avr);
+	} while (state != cpu_Done && state != cpu_Crashed);
+
+	avr_terminate(avr);
+	return state == cpu_Crashed;
+}